@@ -1,58 +1,188 @@
-// This astar implementation is purposely implemented in such
-// a way that makes it easier for the reader to see how it is
-// just a modified dijkstra algorihtm with the addition
-// of a heuristic function and a goal node given a starting node.
-// see algorihtms/graph/dijkstra.cpp to compare the two.
-
-// In dijkstra, the second element in each pair in the priority queue
-// is just the distance from the start node to that node, so
-// {x, d} means the distance from start to x is d.
-
-// In A*, the second element in each pair in the priority queue has
-// and added information called the heuristic, which is the distance
-// from that node to the goal, auto solution = Solution();
-// {x, dh} means the distance from start to x + distance from x to goal
-// where dh = dists[x] + heuristic(x, goal)
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_test_macros.hpp>
 
 #include "bits/stdc++.h"
+#include "astar.h"
+#include "dijkstra.h"
 
 using namespace std;
 
-vector<int> astar(int n, vector<vector<int>> g[], int s, int goal,
-                  vector<int> heuristic) {
-    vector<int> dists(n, INT_MAX);
-    dists[s] = 0;
+int heuristic(int node, int goal) {
+    // This example uses a simple Euclidean distance for the heuristic.
+    // The actual implementation would depend on the specific problem.
+    return abs(goal - node);
+}
 
-    priority_queue<pair<int, int>, vector<pair<int, int>>,
-                   greater<pair<int, int>>> pq;
-    pq.push({s, heuristic[s]});
+TEST_CASE("A* algorithm test cases") {
+    SECTION("Path graph with an admissible heuristic") {
+        // 0 - 1 - 2 - 3 - 4 with unit weights, plus a costly shortcut 0 - 4.
+        int n = 5;
+        vector<vector<int>> g[5] = {
+            {{1, 1}, {4, 10}},
+            {{0, 1}, {2, 1}},
+            {{1, 1}, {3, 1}},
+            {{2, 1}, {4, 1}},
+            {{3, 1}, {0, 10}}
+        };
+        vector<int> h(n);
+        for (int i = 0; i < n; i++) h[i] = heuristic(i, 4);
 
-    while (!pq.empty()) {
-        pair<int, int> curr = pq.top();
-        int node = curr.first;
-        int dist = dists[node];
-        pq.pop();
+        vector<int> result = astar(n, g, 0, 4, h);
+        REQUIRE(result[4] == 4);
+    }
 
-        if (node == goal) {
-            break; // Stop if we've reached the goal
+    SECTION("Zero heuristic matches dijkstra at the goal") {
+        int n = 5;
+        vector<vector<int>> g[5] = {
+            {{1, 2}, {3, 6}},
+            {{0, 2}, {2, 3}, {3, 8}, {4, 5}},
+            {{1, 3}, {4, 7}},
+            {{0, 6}, {1, 8}},
+            {{1, 5}, {2, 7}}
+        };
+        vector<int> h(n, 0);
+        vector<int> expected = dijkstra(n, g, 0);
+        for (int goal = 0; goal < n; goal++) {
+            REQUIRE(astar(n, g, 0, goal, h)[goal] == expected[goal]);
         }
+    }
 
-        for (const auto &p : g[node]) {
-            int nbr = p[0];
-            int weight = p[1];
+    SECTION("Unreachable goal") {
+        vector<vector<int>> g[3] = {
+            {{1, 1}},
+            {{0, 1}},
+            {}
+        };
+        vector<int> h(3, 0);
+        REQUIRE(astar(3, g, 0, 2, h)[2] == INT_MAX);
+    }
+}
 
-            if (dist + weight < dists[nbr]) {
-                dists[nbr] = dist + weight;
-                pq.push({nbr, dists[nbr] + heuristic[nbr]});
-            }
+TEST_CASE("A* algorithm with templated types") {
+    int n = 500;
+    vector<vector<WeightedEdge<uint32_t, uint16_t>>> g(n);
+    mt19937 rng(5);
+    for (int i = 0; i < 8 * n; i++) {
+        uint32_t u = rng() % n, v = rng() % n;
+        uint16_t w = 1 + rng() % 1000;
+        g[u].push_back({v, w});
+    }
+
+    vector<uint64_t> exact = dijkstra(n, g.data(), 0u);
+    vector<uint64_t> zero(n, 0);
+    for (uint32_t goal = 0; goal < 20; goal++) {
+        REQUIRE(astar(n, g.data(), 0u, goal, zero)[goal] == exact[goal]);
+    }
+}
+
+// Check that a grid path only steps between free, adjacent cells and that its
+// cost is the sum of the step costs.
+void require_valid_path(const GridGraph& grid, const GridPath& path, int s, int goal) {
+    REQUIRE(path.cells.front() == s);
+    REQUIRE(path.cells.back() == goal);
+
+    double cost = 0;
+    for (size_t i = 1; i < path.cells.size(); i++) {
+        int a = path.cells[i - 1], b = path.cells[i];
+        REQUIRE(grid.free(grid.x_of(b), grid.y_of(b)));
+
+        double step = -1;
+        grid.for_each_neighbor(a, [&](int nbr, double c) { if (nbr == b) step = c; });
+        REQUIRE(step > 0);
+        cost += step;
+    }
+    REQUIRE(abs(cost - path.cost) < 1e-6);
+}
+
+TEST_CASE("A* on implicit grids") {
+    SECTION("Open grid, 4-connected") {
+        GridGraph grid(10, 10, GridMoves::Four);
+        GridPath path = astar(grid, grid.id(0, 0), grid.id(9, 9));
+        REQUIRE(path.cost == 18);
+        REQUIRE(path.cells.size() == 19);
+        require_valid_path(grid, path, grid.id(0, 0), grid.id(9, 9));
+    }
+
+    SECTION("Open grid, 8-connected") {
+        GridGraph grid(10, 10);
+        for (auto mode : {GridSearch::AStar, GridSearch::JumpPoint}) {
+            GridPath path = astar(grid, grid.id(0, 0), grid.id(9, 4), mode);
+            REQUIRE(abs(path.cost - (5 + 4 * GridGraph::SQRT2)) < 1e-9);
+            require_valid_path(grid, path, grid.id(0, 0), grid.id(9, 4));
         }
     }
 
-    return dists;
+    SECTION("Wall with a gap") {
+        // Column x = 5 is blocked except for y = 8.
+        GridGraph grid(10, 10);
+        for (int y = 0; y < 10; y++) {
+            if (y != 8) grid.set_blocked(5, y);
+        }
+        for (auto mode : {GridSearch::AStar, GridSearch::JumpPoint}) {
+            GridPath path = astar(grid, grid.id(0, 0), grid.id(9, 0), mode);
+            require_valid_path(grid, path, grid.id(0, 0), grid.id(9, 0));
+            REQUIRE(find(path.cells.begin(), path.cells.end(), grid.id(5, 8)) != path.cells.end());
+        }
+    }
+
+    SECTION("Unreachable goal") {
+        GridGraph grid(5, 5);
+        for (int y = 0; y < 5; y++) grid.set_blocked(2, y);
+        for (auto mode : {GridSearch::AStar, GridSearch::JumpPoint}) {
+            GridPath path = astar(grid, grid.id(0, 0), grid.id(4, 4), mode);
+            REQUIRE(path.cost == infinity<double>());
+            REQUIRE(path.cells.empty());
+        }
+    }
+
+    SECTION("Start is the goal") {
+        GridGraph grid(3, 3);
+        GridPath path = astar(grid, 4, 4, GridSearch::JumpPoint);
+        REQUIRE(path.cost == 0);
+        REQUIRE(path.cells == vector<int>{4});
+    }
 }
 
-int heuristic(int node, int goal) {
-    // This example uses a simple Euclidean distance for the heuristic.
-    // The actual implementation would depend on the specific problem.
-    return abs(goal - node);
+TEST_CASE("Jump Point Search matches A* and dijkstra on random grids") {
+    mt19937 rng(17);
+    for (double density : {0.0, 0.1, 0.25, 0.35}) {
+        int width = 60, height = 40;
+        GridGraph grid(width, height);
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                if ((rng() % 1000) < density * 1000) grid.set_blocked(x, y);
+            }
+        }
+
+        // Explicit adjacency list of the same grid for dijkstra.
+        int n = grid.size();
+        auto explicit_edges = [&]() {
+            vector<vector<WeightedEdge<int, double>>> g(n);
+            for (int v = 0; v < n; v++) {
+                if (!grid.free(grid.x_of(v), grid.y_of(v))) continue;
+                grid.for_each_neighbor(v, [&](int nbr, double cost) { g[v].push_back({nbr, cost}); });
+            }
+            return g;
+        };
+
+        for (int query = 0; query < 20; query++) {
+            int s = rng() % n, goal = rng() % n;
+            grid.set_blocked(grid.x_of(s), grid.y_of(s), false);
+            grid.set_blocked(grid.x_of(goal), grid.y_of(goal), false);
+            auto g = explicit_edges();
+
+            double expected = dijkstra(n, g.data(), s)[goal];
+            GridPath plain = astar(grid, s, goal, GridSearch::AStar);
+            GridPath jps = astar(grid, s, goal, GridSearch::JumpPoint);
+
+            if (expected == infinity<double>()) {
+                REQUIRE(plain.cells.empty());
+                REQUIRE(jps.cells.empty());
+                continue;
+            }
+            REQUIRE(abs(plain.cost - expected) < 1e-6);
+            REQUIRE(abs(jps.cost - expected) < 1e-6);
+            require_valid_path(grid, jps, s, goal);
+        }
+    }
 }
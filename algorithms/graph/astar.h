@@ -0,0 +1,261 @@
+// This astar implementation is purposely implemented in such
+// a way that makes it easier for the reader to see how it is
+// just a modified dijkstra algorihtm with the addition
+// of a heuristic function and a goal node given a starting node.
+// see algorihtms/graph/dijkstra.h to compare the two.
+
+// In dijkstra, the key of each entry in the priority queue
+// is just the distance from the start node to that node, so
+// {d, x} means the distance from start to x is d.
+
+// In A*, the key of each entry in the priority queue has
+// and added information called the heuristic, which is the distance
+// from that node to the goal, auto solution = Solution();
+// {dh, x} means the distance from start to x + distance from x to goal
+// where dh = dists[x] + heuristic(x, goal)
+
+// The generic astar<Vertex, Weight, Dist, Queue>(n, g, s, goal, heuristic) takes
+// vector<WeightedEdge<Vertex, Weight>> adjacency lists (see shortest_path.h) and
+// a heuristic of the distance type. Both versions add with saturating_add().
+
+// There is also a specialization for implicit grids (see grid_graph.h):
+// astar(grid, s, goal, mode) takes the heuristic from the grid itself (Manhattan
+// or octile distance) and keeps per-query state in a hash map, so nothing of
+// size width * height is allocated per query. With GridSearch::JumpPoint on an
+// 8-connected grid it runs Jump Point Search (Harabor and Grastien, 2011): from
+// each expanded cell it only follows the neighbors that are not reachable at
+// least as cheaply through its parent, and it scans along straight lines and
+// diagonals until it hits a cell with a forced neighbor (a jump point) instead
+// of pushing every cell it passes. This prunes the many symmetric paths of
+// equal length that plain A* would expand on open grids.
+
+#ifndef ASTAR_H
+#define ASTAR_H
+
+#include "bits/stdc++.h"
+#include "grid_graph.h"
+#include "shortest_path.h"
+
+// for_each_edge(u, f) calls f(v, w) for every edge u -> v with weight w.
+template <typename Dist, typename Queue, typename Vertex, typename ForEachEdge>
+std::vector<Dist> astar_impl(Vertex n, Vertex s, Vertex goal,
+                             const std::vector<Dist>& heuristic,
+                             ForEachEdge&& for_each_edge) {
+    std::vector<Dist> dists(n, infinity<Dist>());
+    dists[s] = 0;
+
+    Queue pq;
+    pq.push(heuristic[s], s);
+
+    while (!pq.empty()) {
+        auto [dh, node] = pq.pop();
+        Dist dist = dists[node];
+
+        // Skip entries made stale by a later, shorter path to the same node.
+        if (dh > saturating_add(dist, heuristic[node])) {
+            continue;
+        }
+
+        if (node == goal) {
+            break; // Stop if we've reached the goal
+        }
+
+        for_each_edge(node, [&](Vertex nbr, auto weight) {
+            Dist next = saturating_add(dist, weight);
+            if (next < dists[nbr]) {
+                dists[nbr] = next;
+                pq.push(saturating_add(next, heuristic[nbr]), nbr);
+            }
+        });
+    }
+
+    return dists;
+}
+
+template <typename Vertex, typename Weight, typename Dist = distance_t<Weight>,
+          typename Queue = DaryHeapQueue<Dist, Vertex>>
+std::vector<Dist> astar(std::type_identity_t<Vertex> n,
+                        const std::vector<WeightedEdge<Vertex, Weight>> g[],
+                        Vertex s, Vertex goal, const std::vector<Dist>& heuristic) {
+    return astar_impl<Dist, Queue>(n, s, goal, heuristic, [&](Vertex u, auto&& relax) {
+        for (const auto &edge : g[u]) relax(edge.to, edge.weight);
+    });
+}
+
+inline std::vector<int> astar(int n, std::vector<std::vector<int>> g[], int s, int goal,
+                              std::vector<int> heuristic) {
+    return astar_impl<int, DaryHeapQueue<int, int>>(n, s, goal, heuristic,
+                                                      [&](int u, auto&& relax) {
+        for (const auto &p : g[u]) relax(p[0], p[1]);
+    });
+}
+
+enum class GridSearch { AStar, JumpPoint };
+
+struct GridPath {
+    double cost;            // infinity<double>() if the goal is unreachable
+    std::vector<int> cells; // every cell from start to goal, empty if unreachable
+};
+
+// Scan from (x, y) in direction (dx, dy) and return the first jump point, or -1
+// if the scan runs into a wall. Cells with a forced neighbor, the goal, and
+// diagonal cells from which a straight scan finds a jump point are jump points.
+inline int grid_jump(const GridGraph& grid, int x, int y, int dx, int dy, int goal) {
+    while (true) {
+        if (!grid.free(x, y)) {
+            return -1;
+        }
+        int v = grid.id(x, y);
+        if (v == goal) {
+            return v;
+        }
+
+        if (dx != 0 && dy != 0) {
+            if (grid_jump(grid, x + dx, y, dx, 0, goal) >= 0 ||
+                grid_jump(grid, x, y + dy, 0, dy, goal) >= 0) {
+                return v;
+            }
+            // The next diagonal step would cut a corner.
+            if (!grid.free(x + dx, y) || !grid.free(x, y + dy)) {
+                return -1;
+            }
+        }
+        else if (dx != 0) {
+            if ((grid.free(x, y - 1) && !grid.free(x - dx, y - 1)) ||
+                (grid.free(x, y + 1) && !grid.free(x - dx, y + 1))) {
+                return v;
+            }
+        }
+        else {
+            if ((grid.free(x - 1, y) && !grid.free(x - 1, y - dy)) ||
+                (grid.free(x + 1, y) && !grid.free(x + 1, y - dy))) {
+                return v;
+            }
+        }
+
+        x += dx;
+        y += dy;
+    }
+}
+
+// Call f(dx, dy) for every direction Jump Point Search has to follow from v,
+// given that v was reached from parent (-1 for the start cell).
+template <typename F>
+void grid_jump_directions(const GridGraph& grid, int v, int parent, F&& f) {
+    int x = grid.x_of(v), y = grid.y_of(v);
+    if (parent < 0) {
+        grid.for_each_neighbor(v, [&](int nbr, double) {
+            f(grid.x_of(nbr) - x, grid.y_of(nbr) - y);
+        });
+        return;
+    }
+
+    int dx = (x > grid.x_of(parent)) - (x < grid.x_of(parent));
+    int dy = (y > grid.y_of(parent)) - (y < grid.y_of(parent));
+
+    if (dx != 0 && dy != 0) {
+        bool horizontal = grid.free(x + dx, y), vertical = grid.free(x, y + dy);
+        if (vertical) f(0, dy);
+        if (horizontal) f(dx, 0);
+        if (horizontal && vertical) f(dx, dy);
+    }
+    else if (dx != 0) {
+        bool next = grid.free(x + dx, y);
+        bool down = grid.free(x, y + 1), up = grid.free(x, y - 1);
+        if (next) {
+            f(dx, 0);
+            if (down) f(dx, 1);
+            if (up) f(dx, -1);
+        }
+        if (down) f(0, 1);
+        if (up) f(0, -1);
+    }
+    else {
+        bool next = grid.free(x, y + dy);
+        bool right = grid.free(x + 1, y), left = grid.free(x - 1, y);
+        if (next) {
+            f(0, dy);
+            if (right) f(1, dy);
+            if (left) f(-1, dy);
+        }
+        if (right) f(1, 0);
+        if (left) f(-1, 0);
+    }
+}
+
+inline GridPath astar(const GridGraph& grid, int s, int goal, GridSearch mode = GridSearch::AStar) {
+    // Jump Point Search is only defined here for 8-connected grids.
+    bool jump = mode == GridSearch::JumpPoint && grid.movement() == GridMoves::Eight;
+
+    struct Visit {
+        double dist;
+        int parent;
+    };
+    std::unordered_map<int, Visit> visits;
+    visits[s] = {0.0, -1};
+
+    DaryHeapQueue<double, int> pq;
+    pq.push(grid.distance(s, goal), s);
+
+    auto relax = [&](int node, double dist, int nbr, double cost) {
+        double next = dist + cost;
+        auto [it, inserted] = visits.try_emplace(nbr, Visit{next, node});
+        if (inserted || next < it->second.dist) {
+            it->second = {next, node};
+            pq.push(next + grid.distance(nbr, goal), nbr);
+        }
+    };
+
+    bool found = false;
+    while (!pq.empty()) {
+        auto [dh, node] = pq.pop();
+        Visit visit = visits[node];
+
+        // Skip entries made stale by a later, shorter path to the same node.
+        if (dh > visit.dist + grid.distance(node, goal)) {
+            continue;
+        }
+
+        if (node == goal) {
+            found = true;
+            break; // Stop if we've reached the goal
+        }
+
+        if (!jump) {
+            grid.for_each_neighbor(node, [&](int nbr, double cost) {
+                relax(node, visit.dist, nbr, cost);
+            });
+            continue;
+        }
+
+        int x = grid.x_of(node), y = grid.y_of(node);
+        grid_jump_directions(grid, node, visit.parent, [&](int dx, int dy) {
+            int jump_point = grid_jump(grid, x + dx, y + dy, dx, dy, goal);
+            if (jump_point >= 0) {
+                relax(node, visit.dist, jump_point, grid.distance(node, jump_point));
+            }
+        });
+    }
+
+    if (!found) {
+        return {infinity<double>(), {}};
+    }
+
+    // Walk the parents back from the goal. Jump points are joined by straight
+    // or diagonal segments, so fill in the cells in between one step at a time.
+    std::vector<int> cells = {goal};
+    for (int v = goal; visits[v].parent >= 0; v = visits[v].parent) {
+        int p = visits[v].parent;
+        int dx = (grid.x_of(p) > grid.x_of(v)) - (grid.x_of(p) < grid.x_of(v));
+        int dy = (grid.y_of(p) > grid.y_of(v)) - (grid.y_of(p) < grid.y_of(v));
+        for (int c = v; c != p; ) {
+            c = grid.id(grid.x_of(c) + dx, grid.y_of(c) + dy);
+            cells.push_back(c);
+        }
+    }
+    std::reverse(cells.begin(), cells.end());
+
+    return {visits[goal].dist, cells};
+}
+
+#endif // end of astar.h definition
@@ -1,51 +1,10 @@
-/* =====================================================================================
-   This file contains the implementation of the Bellman-Ford's algorithm. It returns
-   the shortest distance from the starting node to all other nodes.
-
-   @param n:            the number of vertices in the graph
-   @param e:            the edge list representation of the graph
-   @param s:            the starting node
-   @return vector<int>: the shortest distance from the starting node to all other nodes,
-                        {-1} if there is a negative cycle in the graph
-
-   @author: Muhammad Fadli Alim Arsani
-======================================================================================*/
-
 #define CATCH_CONFIG_MAIN
 #include <catch2/catch_test_macros.hpp>
 
 #include "bits/stdc++.h"
+#include "bellman_ford.h"
 using namespace std;
 
-vector<int> bellman_ford(int n, vector<vector<int>>& e, int s) {
-  vector<int> dists(n, INT_MAX);
-  dists[s] = 0;
-
-  for (int i=0; i<n-1; i++) {
-    for (const auto& edge : e) {
-      int u = edge[0], v = edge[1], w = edge[2];
-
-      // Edge relaxation step
-      if (dists[u] != INT_MAX && dists[u] + w < dists[v]) {
-        dists[v] = dists[u] + w;
-      }
-    }
-  }
-
-  // Check for negative cycle existence by doing
-  // one more iteration (i.e: n iteration instead of n-1)
-  for (const auto& edge : e) {
-    int u = edge[0], v = edge[1], w = edge[2];
-
-    // Edge relaxation step
-    if (dists[u] != INT_MAX && dists[u] + w < dists[v]) {
-      return {-1};
-    }
-  }
-
-  return dists;
-}
-
 TEST_CASE("Bellman-Ford algorithm test cases") {
     SECTION("Simple graph without negative weights") {
         int n = 5;
@@ -123,3 +82,54 @@ TEST_CASE("Bellman-Ford algorithm test cases") {
     }
 }
 
+TEST_CASE("Bellman-Ford algorithm with templated types") {
+    SECTION("Narrow weights and vertex ids") {
+        vector<WeightedArc<uint32_t, uint16_t>> e = {
+            {0, 1, 2},
+            {0, 3, 6},
+            {1, 2, 3},
+            {1, 3, 8},
+            {1, 4, 5},
+            {2, 4, 7},
+            {3, 4, 9}
+        };
+        vector<uint64_t> expected = {0, 2, 5, 6, 7};
+        REQUIRE(bellman_ford(5, e, 0u) == expected);
+    }
+
+    SECTION("Negative weights with 64-bit vertex ids") {
+        vector<WeightedArc<int64_t, int8_t>> e = {
+            {0, 1, -1},
+            {0, 2, 4},
+            {1, 2, 3},
+            {1, 3, 2},
+            {1, 4, 2},
+            {3, 2, 5},
+            {3, 1, 1},
+            {4, 3, -3}
+        };
+        vector<int64_t> expected = {0, -1, 2, -2, 1};
+        REQUIRE(bellman_ford(5, e, int64_t(0)) == expected);
+    }
+
+    SECTION("Negative cycle") {
+        vector<WeightedArc<int, int>> e = {
+            {0, 1, 1},
+            {1, 2, -1},
+            {2, 3, -1},
+            {3, 0, -1}
+        };
+        vector<int64_t> expected = {-1};
+        REQUIRE(bellman_ford(4, e, 0) == expected);
+    }
+
+    SECTION("Long paths saturate instead of overflowing") {
+        vector<WeightedArc<int, int>> e = {
+            {0, 1, INT_MAX - 1},
+            {1, 2, INT_MAX - 1},
+            {2, 3, 1}
+        };
+        vector<int> expected = {0, INT_MAX - 1, INT_MAX, INT_MAX};
+        REQUIRE(bellman_ford<int, int, int>(4, e, 0) == expected);
+    }
+}
@@ -0,0 +1,72 @@
+/* =====================================================================================
+   This file contains the implementation of the Bellman-Ford's algorithm. It returns
+   the shortest distance from the starting node to all other nodes.
+
+   Besides the int interface, bellman_ford<Vertex, Weight, Dist>(n, e, s) takes a
+   vector<WeightedArc<Vertex, Weight>> (see shortest_path.h). Both add weights with
+   saturating_add(), so distances never overflow.
+
+   @param n:            the number of vertices in the graph
+   @param e:            the edge list representation of the graph
+   @param s:            the starting node
+   @return vector<int>: the shortest distance from the starting node to all other nodes,
+                        {-1} if there is a negative cycle in the graph
+
+   @author: Muhammad Fadli Alim Arsani
+======================================================================================*/
+
+#ifndef BELLMAN_FORD_H
+#define BELLMAN_FORD_H
+
+#include "bits/stdc++.h"
+#include "shortest_path.h"
+
+// for_each_edge(f) calls f(u, v, w) for every edge u -> v with weight w.
+template <typename Dist, typename Vertex, typename ForEachEdge>
+std::vector<Dist> bellman_ford_impl(Vertex n, Vertex s, ForEachEdge&& for_each_edge) {
+  std::vector<Dist> dists(n, infinity<Dist>());
+  dists[s] = 0;
+
+  for (Vertex i=0; i+1<n; i++) {
+    for_each_edge([&](Vertex u, Vertex v, auto w) {
+      // Edge relaxation step
+      if (dists[u] != infinity<Dist>() && saturating_add(dists[u], w) < dists[v]) {
+        dists[v] = saturating_add(dists[u], w);
+      }
+    });
+  }
+
+  // Check for negative cycle existence by doing
+  // one more iteration (i.e: n iteration instead of n-1)
+  bool negative_cycle = false;
+  for_each_edge([&](Vertex u, Vertex v, auto w) {
+    // Edge relaxation step
+    if (dists[u] != infinity<Dist>() && saturating_add(dists[u], w) < dists[v]) {
+      negative_cycle = true;
+    }
+  });
+  if (negative_cycle) {
+    return {static_cast<Dist>(-1)};
+  }
+
+  return dists;
+}
+
+template <typename Vertex, typename Weight, typename Dist = distance_t<Weight>>
+std::vector<Dist> bellman_ford(std::type_identity_t<Vertex> n,
+                               const std::vector<WeightedArc<Vertex, Weight>>& e, Vertex s) {
+  static_assert(std::is_signed_v<Dist> || std::is_unsigned_v<Weight>,
+                "negative weights need a signed distance type");
+
+  return bellman_ford_impl<Dist>(n, s, [&](auto&& relax) {
+    for (const auto& edge : e) relax(edge.from, edge.to, edge.weight);
+  });
+}
+
+inline std::vector<int> bellman_ford(int n, std::vector<std::vector<int>>& e, int s) {
+  return bellman_ford_impl<int>(n, s, [&](auto&& relax) {
+    for (const auto& edge : e) relax(edge[0], edge[1], edge[2]);
+  });
+}
+
+#endif // end of bellman_ford.h definition
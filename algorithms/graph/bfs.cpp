@@ -1,98 +1,8 @@
-/* ==============================================================================
-   This is an implementation of the Breadth First Search (DFS) algorithm.
-   The implementation assumes the starting node to be `0` by
-   default. It then prints the visited nodes in the order they are visited.
-
-   @param n: the number of vertices in the graph
-   @param adj_mat:  the adjacency matrix representation of the graph
-     or
-   @param adj_list: the adjacency list representation of the graph
-
-   @author: Muhammad Fadli Alim Arsani
-===============================================================================*/
-
 #define CATCH_CONFIG_MAIN
 #include <catch2/catch_test_macros.hpp>
 
 #include "bits/stdc++.h"
-
-// ======================================================
-// BFS implementation: Adjacency matrix
-// ======================================================
-void bfs(int n, std::vector<std::vector<int>>& adj_mat) {
-  std::vector<int> record;
-
-  // ====================================================
-  std::queue<int> q;
-  q.push(0);
-  std::vector<bool> visited(n, false);
-
-  while (!q.empty()) {
-    int node = q.front();
-    q.pop();
-
-    if (!visited[node]) {
-      visited[node] = true;
-
-      record.push_back(node);
-
-      for (int i = 0; i < n; i++) {
-        if (adj_mat[node][i] && !visited[i]) q.push(i);
-      }
-    }
-  }
-  // ====================================================
-
-  std::cout << "[";
-  for (int i = 0; i < record.size(); i++) {
-    if (i == record.size() - 1) {
-      std::cout << record[i];
-    }
-    else {
-      std::cout << record[i] << ", ";
-    }
-  }
-  std::cout << "]" << std::endl;
-}
-
-// ======================================================
-// BFS implementation: Adjacency list
-// ======================================================
-void bfs(int n, std::vector<int> adj_list[]) {
-  std::vector<int> record;
-
-  // ====================================================
-  std::queue<int> q;
-  q.push(0);
-  std::vector<bool> visited(n, false);
-
-  while (!q.empty()) {
-    int node = q.front();
-    q.pop();
-
-    if (!visited[node]) {
-      visited[node] = true;
-
-      record.push_back(node);
-
-      for (auto const& neighbor : adj_list[node]) {
-        if (!visited[neighbor]) q.push(neighbor);
-      }
-    }
-  }
-  // ====================================================
-
-  std::cout << "[";
-  for (int i = 0; i < record.size(); i++) {
-    if (i == record.size() - 1) {
-      std::cout << record[i];
-    }
-    else {
-      std::cout << record[i] << ", ";
-    }
-  }
-  std::cout << "]" << std::endl;
-}
+#include "bfs.h"
 
 TEST_CASE("BFS with adjacency matrix", "[bfs][adjacency_matrix]") {
   int n = 4;
@@ -215,3 +125,103 @@ TEST_CASE("BFS with single node graph - adjacency list", "[bfs][adjacency_list]"
 
   REQUIRE(oss.str() == "[0]\n");
 }
+
+TEST_CASE("BFS with compressed adjacency list", "[bfs][compressed]") {
+  int n = 4;
+  std::vector<int> adj_list[4];
+  adj_list[0] = {3, 1};
+  adj_list[1] = {2, 0};
+  adj_list[2] = {1, 3};
+  adj_list[3] = {2, 0};
+  CompressedGraph g(n, adj_list);
+
+  // Capture the output
+  std::ostringstream oss;
+  std::streambuf* p_cout_streambuf = std::cout.rdbuf();
+  std::cout.rdbuf(oss.rdbuf());
+
+  bfs(g);
+
+  // Restore the original stream buffer
+  std::cout.rdbuf(p_cout_streambuf);
+
+  REQUIRE(oss.str() == "[0, 1, 3, 2]\n");
+}
+
+TEST_CASE("BFS with disconnected graph - compressed adjacency list", "[bfs][compressed]") {
+  int n = 5;
+  std::vector<int> adj_list[5];
+  adj_list[0] = {1};
+  adj_list[1] = {0, 2};
+  adj_list[2] = {1};
+  adj_list[3] = {4};
+  adj_list[4] = {3};
+  CompressedGraph g(n, adj_list);
+
+  // Capture the output
+  std::ostringstream oss;
+  std::streambuf* p_cout_streambuf = std::cout.rdbuf();
+  std::cout.rdbuf(oss.rdbuf());
+
+  bfs(g);
+
+  // Restore the original stream buffer
+  std::cout.rdbuf(p_cout_streambuf);
+
+  REQUIRE(oss.str() == "[0, 1, 2]\n");
+}
+
+TEST_CASE("Compressed adjacency list decodes every neighbor", "[compressed]") {
+  int n = 1000;
+  std::vector<int> adj_list[1000];
+  std::mt19937 rng(42);
+  for (int v = 0; v < n; v++) {
+    int degree = rng() % 20;
+    for (int i = 0; i < degree; i++) {
+      adj_list[v].push_back(rng() % n);
+    }
+  }
+  // Far-away and duplicate neighbors need multi-byte and zero gaps.
+  adj_list[0] = {999, 0, 500, 500};
+  adj_list[999] = {0};
+
+  CompressedGraph g(n, adj_list);
+  REQUIRE(g.size() == n);
+
+  std::size_t n_edges = 0;
+  for (int v = 0; v < n; v++) {
+    std::vector<int> expected = adj_list[v];
+    std::sort(expected.begin(), expected.end());
+
+    std::vector<int> decoded;
+    g.for_each_neighbor(v, [&](int nbr) { decoded.push_back(nbr); });
+
+    REQUIRE(decoded == expected);
+    REQUIRE(g.degree(v) == (int)expected.size());
+    n_edges += expected.size();
+  }
+
+  REQUIRE(g.bytes() < n_edges * sizeof(int) + (n + 1) * sizeof(std::size_t));
+}
+
+TEST_CASE("BFS order without printing", "[bfs][adjacency_list][compressed]") {
+  int n = 4;
+  std::vector<int> adj_list[4];
+  adj_list[0] = {1, 3};
+  adj_list[1] = {0, 2};
+  adj_list[2] = {1, 3};
+  adj_list[3] = {0, 2};
+  CompressedGraph g(n, adj_list);
+
+  std::ostringstream oss;
+  std::streambuf* p_cout_streambuf = std::cout.rdbuf();
+  std::cout.rdbuf(oss.rdbuf());
+
+  std::vector<int> order = bfs_order(n, adj_list);
+  std::vector<int> compressed_order = bfs_order(g);
+
+  std::cout.rdbuf(p_cout_streambuf);
+  REQUIRE(oss.str().empty());
+  REQUIRE(order == std::vector<int>{0, 1, 3, 2});
+  REQUIRE(compressed_order == order);
+}
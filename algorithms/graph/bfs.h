@@ -0,0 +1,128 @@
+/* ==============================================================================
+   This is an implementation of the Breadth First Search (DFS) algorithm.
+   The implementation assumes the starting node to be `0` by
+   default. It then prints the visited nodes in the order they are visited.
+   bfs_order() does the traversal and returns that order without printing it.
+
+   @param n: the number of vertices in the graph
+   @param adj_mat:  the adjacency matrix representation of the graph
+     or
+   @param adj_list: the adjacency list representation of the graph
+     or
+   @param g:        the compressed (gap + varint encoded) representation of
+                    the graph, see compressed_graph.h
+
+   @author: Muhammad Fadli Alim Arsani
+===============================================================================*/
+
+#ifndef BFS_H
+#define BFS_H
+
+#include "bits/stdc++.h"
+#include "compressed_graph.h"
+#include "print_record.h"
+
+// ======================================================
+// BFS implementation: Adjacency matrix
+// ======================================================
+inline std::vector<int> bfs_order(int n, std::vector<std::vector<int>>& adj_mat) {
+  std::vector<int> record;
+
+  // ====================================================
+  std::queue<int> q;
+  q.push(0);
+  std::vector<bool> visited(n, false);
+
+  while (!q.empty()) {
+    int node = q.front();
+    q.pop();
+
+    if (!visited[node]) {
+      visited[node] = true;
+
+      record.push_back(node);
+
+      for (int i = 0; i < n; i++) {
+        if (adj_mat[node][i] && !visited[i]) q.push(i);
+      }
+    }
+  }
+  // ====================================================
+
+  return record;
+}
+
+inline void bfs(int n, std::vector<std::vector<int>>& adj_mat) {
+  print_record(bfs_order(n, adj_mat));
+}
+
+// ======================================================
+// BFS implementation: Adjacency list
+// ======================================================
+inline std::vector<int> bfs_order(int n, std::vector<int> adj_list[]) {
+  std::vector<int> record;
+
+  // ====================================================
+  std::queue<int> q;
+  q.push(0);
+  std::vector<bool> visited(n, false);
+
+  while (!q.empty()) {
+    int node = q.front();
+    q.pop();
+
+    if (!visited[node]) {
+      visited[node] = true;
+
+      record.push_back(node);
+
+      for (auto const& neighbor : adj_list[node]) {
+        if (!visited[neighbor]) q.push(neighbor);
+      }
+    }
+  }
+  // ====================================================
+
+  return record;
+}
+
+inline void bfs(int n, std::vector<int> adj_list[]) {
+  print_record(bfs_order(n, adj_list));
+}
+
+// ======================================================
+// BFS implementation: Compressed adjacency list
+// ======================================================
+inline std::vector<int> bfs_order(const CompressedGraph& g) {
+  std::vector<int> record;
+
+  // ====================================================
+  int n = g.size();
+  std::queue<int> q;
+  q.push(0);
+  std::vector<bool> visited(n, false);
+
+  while (!q.empty()) {
+    int node = q.front();
+    q.pop();
+
+    if (!visited[node]) {
+      visited[node] = true;
+
+      record.push_back(node);
+
+      g.for_each_neighbor(node, [&](int neighbor) {
+        if (!visited[neighbor]) q.push(neighbor);
+      });
+    }
+  }
+  // ====================================================
+
+  return record;
+}
+
+inline void bfs(const CompressedGraph& g) {
+  print_record(bfs_order(g));
+}
+
+#endif // end of bfs.h definition
@@ -0,0 +1,132 @@
+/* ==============================================================================
+   This is a compressed, read-only adjacency representation of a graph. Every
+   adjacency list is sorted and gap-encoded: each vertex stores its degree, the
+   first neighbor relative to the vertex itself (zig-zag encoded, since it may
+   be smaller), and then the gaps between consecutive neighbors. All numbers
+   are written as LEB128 varints, so small gaps cost a single byte instead of
+   the 4 bytes of an `int` in `std::vector<int>`.
+
+   Random access goes through a per-vertex byte offset, and neighbors are
+   decoded on the fly by `for_each_neighbor()`, which the traversal loops in
+   bfs.h, dfs.h and kahn.h call directly, so no neighbor list is ever
+   materialized.
+
+   @param n:        the number of vertices in the graph
+   @param adj_list: the adjacency list representation of the graph
+===============================================================================*/
+
+#ifndef COMPRESSED_GRAPH_H
+#define COMPRESSED_GRAPH_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class CompressedGraph {
+  public:
+    CompressedGraph(int n, const std::vector<int> adj_list[])
+        : n_vertices(n), offsets(n + 1, 0) {
+      std::vector<int> sorted;
+      for (int v = 0; v < n; v++) {
+        offsets[v] = data.size();
+
+        sorted.assign(adj_list[v].begin(), adj_list[v].end());
+        std::sort(sorted.begin(), sorted.end());
+
+        put_varint(sorted.size());
+        if (!sorted.empty()) {
+          put_varint(zigzag(static_cast<int64_t>(sorted[0]) - v));
+          for (std::size_t i = 1; i < sorted.size(); i++) {
+            put_varint(static_cast<uint64_t>(sorted[i] - sorted[i-1]));
+          }
+        }
+      }
+      offsets[n] = data.size();
+      data.shrink_to_fit();
+    }
+
+    /**
+     * @brief Get the number of vertices in the graph.
+     * @return The number of vertices in the graph.
+     */
+    int size() const {
+      return n_vertices;
+    }
+
+    /**
+     * @brief Get the out-degree of a vertex without decoding its neighbors.
+     * @param v The vertex.
+     * @return The number of neighbors of v.
+     */
+    int degree(int v) const {
+      const uint8_t* p = data.data() + offsets[v];
+      return static_cast<int>(get_varint(p));
+    }
+
+    /**
+     * @brief Decode the neighbors of a vertex in ascending order and call
+     *        f(neighbor) for each of them.
+     * @param v The vertex whose neighbors are visited.
+     * @param f The callback, invoked once per neighbor.
+     */
+    template <typename F>
+    void for_each_neighbor(int v, F&& f) const {
+      const uint8_t* p = data.data() + offsets[v];
+      uint64_t deg = get_varint(p);
+      if (deg == 0) return;
+
+      int nbr = v + static_cast<int>(unzigzag(get_varint(p)));
+      f(nbr);
+      for (uint64_t i = 1; i < deg; i++) {
+        nbr += static_cast<int>(get_varint(p));
+        f(nbr);
+      }
+    }
+
+    /**
+     * @brief Get the number of bytes used by the encoded graph.
+     * @return The size of the neighbor stream plus the offset table in bytes.
+     */
+    std::size_t bytes() const {
+      return data.size() + offsets.size() * sizeof(uint64_t);
+    }
+
+  private:
+    int n_vertices;
+    std::vector<uint64_t> offsets;
+    std::vector<uint8_t> data;
+
+    void put_varint(uint64_t x) {
+      while (x >= 0x80) {
+        data.push_back(static_cast<uint8_t>(x | 0x80));
+        x >>= 7;
+      }
+      data.push_back(static_cast<uint8_t>(x));
+    }
+
+    static uint64_t get_varint(const uint8_t*& p) {
+      // Fast path: most gaps in a sorted adjacency list fit in one byte.
+      uint64_t x = *p++;
+      if (x < 0x80) return x;
+
+      x &= 0x7f;
+      int shift = 7;
+      while (true) {
+        uint64_t byte = *p++;
+        x |= (byte & 0x7f) << shift;
+        if (byte < 0x80) return x;
+        shift += 7;
+      }
+    }
+
+    static uint64_t zigzag(int64_t x) {
+      return (static_cast<uint64_t>(x) << 1) ^ static_cast<uint64_t>(x >> 63);
+    }
+
+    static int64_t unzigzag(uint64_t x) {
+      return static_cast<int64_t>(x >> 1) ^ -static_cast<int64_t>(x & 1);
+    }
+};
+
+#endif // end of compressed_graph.h definition
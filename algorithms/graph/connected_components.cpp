@@ -0,0 +1,89 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_test_macros.hpp>
+
+#include "bits/stdc++.h"
+#include "connected_components.h"
+using namespace std;
+
+// Random undirected graph made of `n_parts` separate chunks of vertices.
+vector<vector<int>> random_undirected_graph(int n, int n_edges, int n_parts, int seed) {
+  vector<vector<int>> adj(n);
+  mt19937 rng(seed);
+  int part_size = n / n_parts;
+  for (int i = 0; i < n_edges; i++) {
+    int part = rng() % n_parts;
+    int u = part * part_size + rng() % part_size;
+    int v = part * part_size + rng() % part_size;
+    adj[u].push_back(v);
+    adj[v].push_back(u);
+  }
+  return adj;
+}
+
+TEST_CASE("Connected components: small graphs") {
+    SECTION("Single node graph") {
+        vector<int> adj_list[1];
+        vector<int> expected = {0};
+        REQUIRE(connected_components(1, adj_list) == expected);
+    }
+
+    SECTION("Disconnected graph") {
+        vector<int> adj_list[5];
+        adj_list[0] = {1};
+        adj_list[1] = {0, 2};
+        adj_list[2] = {1};
+        adj_list[3] = {4};
+        adj_list[4] = {3};
+        vector<int> expected = {0, 0, 0, 3, 3};
+        REQUIRE(connected_components(5, adj_list) == expected);
+    }
+
+    SECTION("Component id is the smallest vertex in the component") {
+        vector<int> adj_list[6];
+        adj_list[5] = {2};
+        adj_list[2] = {5, 4};
+        adj_list[4] = {2};
+        adj_list[3] = {1};
+        adj_list[1] = {3};
+        vector<int> expected = {0, 1, 2, 1, 2, 2};
+        REQUIRE(connected_components(6, adj_list) == expected);
+    }
+}
+
+TEST_CASE("Connected components: parallel methods match DisjointSet") {
+    int n = 100000;
+    int n_threads = 4;
+
+    SECTION("Giant component plus small ones") {
+        auto adj = random_undirected_graph(n, 4 * n, 1, 1);
+        // Carve out a few isolated vertices and a small separate component.
+        for (auto& nbrs : adj) {
+            nbrs.erase(remove_if(nbrs.begin(), nbrs.end(), [](int v) { return v < 10; }), nbrs.end());
+        }
+        for (int u = 0; u < 10; u++) adj[u].clear();
+        adj[0] = {1};
+        adj[1] = {0};
+
+        vector<int> expected = cc_serial(n, adj.data());
+        REQUIRE(connected_components(n, adj.data(), CCMethod::Afforest, n_threads) == expected);
+        REQUIRE(connected_components(n, adj.data(), CCMethod::LabelPropagation, n_threads) == expected);
+    }
+
+    SECTION("Many medium components") {
+        auto adj = random_undirected_graph(n, n, 50, 2);
+        vector<int> expected = cc_serial(n, adj.data());
+        REQUIRE(connected_components(n, adj.data(), CCMethod::Afforest, n_threads) == expected);
+        REQUIRE(connected_components(n, adj.data(), CCMethod::LabelPropagation, n_threads) == expected);
+    }
+
+    SECTION("Long path") {
+        vector<vector<int>> adj(n);
+        for (int u = 1; u < n; u++) {
+            adj[u - 1].push_back(u);
+            adj[u].push_back(u - 1);
+        }
+        vector<int> expected(n, 0);
+        REQUIRE(connected_components(n, adj.data(), CCMethod::Afforest, n_threads) == expected);
+        REQUIRE(connected_components(n, adj.data(), CCMethod::LabelPropagation, n_threads) == expected);
+    }
+}
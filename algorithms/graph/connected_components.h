@@ -0,0 +1,163 @@
+/* ====================================================================================
+   This file contains a parallel connected components algorithm for undirected graphs.
+   It returns, for every vertex, the id of its component, which is the smallest vertex
+   id in that component.
+
+   The default method is Afforest (Sutton et al., 2018) on top of a lock-free
+   ConcurrentDisjointSet (see data_structures/DisjointSet/disjointset.h):
+     1. Link every vertex with its first few neighbors only (neighbor sampling).
+        On most real graphs this already forms the giant component.
+     2. Guess the giant component by sampling the labels of random vertices.
+     3. Link the remaining edges, skipping vertices that are already in the giant
+        component. Its edges to other components are still seen from the other
+        side since the graph is undirected.
+   The label propagation method (min-label propagation until a fixed point, in the
+   spirit of Shiloach-Vishkin) is kept as a fallback. It does not rely on the
+   adjacency list being symmetric, so it also gives the weakly connected components
+   of a directed graph.
+
+   Small graphs are merged serially with DisjointSet, threads would only add overhead.
+
+   @param n:         the number of vertices in the graph
+   @param adj_list:  the adjacency list representation of the graph
+   @param method:    CCMethod::Afforest (default) or CCMethod::LabelPropagation
+   @param n_threads: the number of worker threads, 0 for all hardware threads
+   @return vector<int>: the component id (smallest vertex id) of every vertex
+
+   @author: Muhammad Fadli Alim Arsani
+=====================================================================================*/
+
+#ifndef CONNECTED_COMPONENTS_H
+#define CONNECTED_COMPONENTS_H
+
+#include "bits/stdc++.h"
+#include "../../data_structures/DisjointSet/disjointset.h"
+
+enum class CCMethod { Afforest, LabelPropagation };
+
+const int CC_SERIAL_CUTOFF = 1 << 14;  // below this many vertices, run serially
+const int CC_NEIGHBOR_ROUNDS = 2;      // neighbors linked per vertex before sampling
+const int CC_SAMPLES = 1024;           // vertices sampled to find the giant component
+
+// Internal helper of the parallel methods: splits [0, n) into chunks and hands them
+// out to n_threads threads dynamically, so that a few high degree vertices do not
+// leave the other threads idle.
+template <typename F>
+void cc_parallel_for(int n, int n_threads, F&& f) {
+  const int chunk = 1024;
+  std::atomic<int> next(0);
+  auto worker = [&]() {
+    while (true) {
+      int begin = next.fetch_add(chunk, std::memory_order_relaxed);
+      if (begin >= n) return;
+      int end = std::min(n, begin + chunk);
+      for (int i = begin; i < end; i++) f(i);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (int t = 1; t < n_threads; t++) threads.emplace_back(worker);
+  worker();
+  for (auto& t : threads) t.join();
+}
+
+inline std::vector<int> cc_serial(int n, std::vector<int> adj_list[]) {
+  DisjointSet ds(n);
+  for (int u = 0; u < n; u++) {
+    for (const auto& v : adj_list[u]) ds.merge(u, v);
+  }
+
+  // DisjointSet picks roots by rank, relabel every set by its smallest element.
+  std::vector<int> smallest(n, INT_MAX);
+  std::vector<int> comp(n);
+  for (int u = 0; u < n; u++) {
+    comp[u] = ds.find(u);
+    smallest[comp[u]] = std::min(smallest[comp[u]], u);
+  }
+  for (int u = 0; u < n; u++) comp[u] = smallest[comp[u]];
+
+  return comp;
+}
+
+inline std::vector<int> cc_afforest(int n, std::vector<int> adj_list[], int n_threads) {
+  ConcurrentDisjointSet ds(n);
+
+  // 1. Neighbor sampling
+  for (int r = 0; r < CC_NEIGHBOR_ROUNDS; r++) {
+    cc_parallel_for(n, n_threads, [&](int u) {
+      if (r < (int)adj_list[u].size()) ds.merge(u, adj_list[u][r]);
+    });
+    cc_parallel_for(n, n_threads, [&](int u) { ds.compress(u); });
+  }
+
+  // 2. Find the most frequent component among a random sample of vertices
+  std::mt19937 rng(n);
+  std::unordered_map<int, int> counts;
+  int giant = 0, giant_count = 0;
+  for (int i = 0; i < CC_SAMPLES; i++) {
+    int c = ds.find(rng() % n);
+    if (++counts[c] > giant_count) {
+      giant = c;
+      giant_count = counts[c];
+    }
+  }
+
+  // 3. Finish the remaining edges of every vertex outside the giant component
+  cc_parallel_for(n, n_threads, [&](int u) {
+    if (ds.find(u) == giant) return;
+    for (int r = CC_NEIGHBOR_ROUNDS; r < (int)adj_list[u].size(); r++) {
+      ds.merge(u, adj_list[u][r]);
+    }
+  });
+
+  std::vector<int> comp(n);
+  cc_parallel_for(n, n_threads, [&](int u) { comp[u] = ds.compress(u); });
+  return comp;
+}
+
+inline std::vector<int> cc_label_propagation(int n, std::vector<int> adj_list[], int n_threads) {
+  std::vector<std::atomic<int>> label(n);
+  cc_parallel_for(n, n_threads, [&](int u) { label[u].store(u, std::memory_order_relaxed); });
+
+  auto lower = [](std::atomic<int>& a, int value) {
+    int curr = a.load(std::memory_order_relaxed);
+    while (value < curr && !a.compare_exchange_weak(curr, value, std::memory_order_relaxed)) {}
+    return value < curr;
+  };
+
+  std::atomic<bool> changed(true);
+  while (changed.load()) {
+    changed.store(false);
+    cc_parallel_for(n, n_threads, [&](int u) {
+      bool local_change = false;
+      for (const auto& v : adj_list[u]) {
+        int lu = label[u].load(std::memory_order_relaxed);
+        int lv = label[v].load(std::memory_order_relaxed);
+        if (lu < lv) local_change |= lower(label[v], lu);
+        else if (lv < lu) local_change |= lower(label[u], lv);
+      }
+      // Pointer jumping: adopt the label of our label, which shortcuts long chains.
+      int lu = label[u].load(std::memory_order_relaxed);
+      local_change |= lower(label[u], label[lu].load(std::memory_order_relaxed));
+      if (local_change) changed.store(true, std::memory_order_relaxed);
+    });
+  }
+
+  std::vector<int> comp(n);
+  for (int u = 0; u < n; u++) comp[u] = label[u].load(std::memory_order_relaxed);
+  return comp;
+}
+
+inline std::vector<int> connected_components(int n, std::vector<int> adj_list[],
+                                 CCMethod method = CCMethod::Afforest,
+                                 int n_threads = 0) {
+  if (n_threads <= 0) n_threads = std::max(1u, std::thread::hardware_concurrency());
+  if (n < CC_SERIAL_CUTOFF || n_threads == 1) return cc_serial(n, adj_list);
+
+  if (method == CCMethod::LabelPropagation) {
+    return cc_label_propagation(n, adj_list, n_threads);
+  }
+  return cc_afforest(n, adj_list, n_threads);
+}
+
+#endif // end of connected_components.h definition
@@ -0,0 +1,207 @@
+/* ====================================================================================
+   This file contains implementations of the Depth First Search (DFS) algorithm using a
+   stack explicitly and using recursion (recursion is using stack implicitly
+   by nature of a function call). The implementation assumes the starting node
+   to be `0` by default. It then prints the visited nodes in the order they
+   are visited. dfs_order() and dfs_r_order() do the traversal and return that
+   order without printing it.
+
+   @param n: the number of vertices in the graph
+   @param adj_mat:  the adjacency matrix representation of the graph
+     or
+   @param adj_list: the adjacency list representation of the graph
+     or
+   @param g:        the compressed (gap + varint encoded) representation of
+                    the graph, see compressed_graph.h
+
+   @author: Muhammad Fadli Alim Arsani
+=====================================================================================*/
+
+#ifndef DFS_H
+#define DFS_H
+
+#include "bits/stdc++.h"
+#include "compressed_graph.h"
+#include "print_record.h"
+
+// ======================================================
+// Stack-based DFS implementation: Adjacency matrix
+// ======================================================
+inline std::vector<int> dfs_order(int n, std::vector<std::vector<int>>& adj_mat) {
+  std::vector<int> record;
+
+  // ====================================================
+  std::stack<int> st;
+  st.push(0);
+  std::vector<bool> visited(n, false);
+
+  while (!st.empty()) {
+    int node = st.top();
+    st.pop();
+
+    if (!visited[node]) {
+      visited[node] = true;
+
+      record.push_back(node);
+
+      for (int i=0; i<n; i++) {
+        if (adj_mat[node][i] && !visited[i]) st.push(i);
+      }
+    }
+  }
+  // ====================================================
+
+  return record;
+}
+
+inline void dfs(int n, std::vector<std::vector<int>>& adj_mat) {
+  print_record(dfs_order(n, adj_mat));
+}
+
+// ======================================================
+// Stack-based DFS implementation: Adjacency list
+// ======================================================
+inline std::vector<int> dfs_order(int n, std::vector<int> adj_list[]) {
+  std::vector<int> record;
+
+  // ====================================================
+  std::stack<int> st;
+  st.push(0);
+  std::vector<bool> visited(n, false);
+
+  while (!st.empty()) {
+    int node = st.top();
+    st.pop();
+
+    if (!visited[node]) {
+      visited[node] = true;
+
+      record.push_back(node);
+
+      for (const auto& neighbor : adj_list[node]) {
+        if (!visited[neighbor]) st.push(neighbor);
+      }
+    }
+  }
+  // ====================================================
+
+  return record;
+}
+
+inline void dfs(int n, std::vector<int> adj_list[]) {
+  print_record(dfs_order(n, adj_list));
+}
+
+// ======================================================
+// Stack-based DFS implementation: Compressed adjacency list
+// ======================================================
+inline std::vector<int> dfs_order(const CompressedGraph& g) {
+  std::vector<int> record;
+
+  // ====================================================
+  int n = g.size();
+  std::stack<int> st;
+  st.push(0);
+  std::vector<bool> visited(n, false);
+
+  while (!st.empty()) {
+    int node = st.top();
+    st.pop();
+
+    if (!visited[node]) {
+      visited[node] = true;
+
+      record.push_back(node);
+
+      g.for_each_neighbor(node, [&](int neighbor) {
+        if (!visited[neighbor]) st.push(neighbor);
+      });
+    }
+  }
+  // ====================================================
+
+  return record;
+}
+
+inline void dfs(const CompressedGraph& g) {
+  print_record(dfs_order(g));
+}
+
+// ======================================================
+// Recursive DFS implementation: Adjacency matrix
+// ======================================================
+inline std::vector<int> dfs_r_order(int n, std::vector<std::vector<int>>& adj_mat) {
+  std::vector<int> record;
+
+  // ======================================================
+  std::vector<bool> visited(n, false);
+
+  std::function<void(int)> dfs = [&](int node) {
+    visited[node] = true;
+
+    record.push_back(node);
+
+    for (int i = 0; i < n; ++i) {
+      if (adj_mat[node][i] && !visited[i]) dfs(i);
+    }
+  };
+
+  // normally, you can just call
+  // dfs(0);
+
+  // but our test case includes disconnected graphs,
+  // so we need to call dfs for each unvisited node.
+  for (int i = 0; i < n; ++i) {
+    if (!visited[i]) {
+      dfs(i);
+    }
+  }
+  // ======================================================
+
+  return record;
+}
+
+inline void dfs_r(int n, std::vector<std::vector<int>>& adj_mat) {
+  print_record(dfs_r_order(n, adj_mat));
+}
+
+// ======================================================
+// Recursive DFS implementation: Adjacency list
+// ======================================================
+inline std::vector<int> dfs_r_order(int n, std::vector<int> adj_list[]) {
+  std::vector<int> record;
+
+  // ======================================================
+  std::vector<bool> visited(n, false);
+
+  std::function<void(int)> dfs = [&](int node) {
+    visited[node] = true;
+
+    record.push_back(node);
+
+    for (const auto& nbr : adj_list[node]) {
+      if (!visited[nbr]) dfs(nbr);
+    }
+
+  };
+
+  // normally, you can just call
+  // dfs(0);
+
+  // but our test case includes disconnected graphs,
+  // so we need to call dfs for each unvisited node.
+  for (int i = 0; i < n; ++i) {
+    if (!visited[i]) {
+      dfs(i);
+    }
+  }
+  // ======================================================
+
+  return record;
+}
+
+inline void dfs_r(int n, std::vector<int> adj_list[]) {
+  print_record(dfs_r_order(n, adj_list));
+}
+
+#endif // end of dfs.h definition
@@ -1,48 +1,10 @@
-/* ====================================================================================
-   This file contains the implementation of the Dijkstra's algorithm using a priority
-   queue. It returns the shortest distance from the starting node to all other nodes.
-
-   @param n: the number of vertices in the graph
-   @param g: the adjacency list representation of the graph
-   @param s: the starting node
-   @return vector<int>: the shortest distance from the starting node to all other nodes
-
-   @author: Muhammad Fadli Alim Arsani
-=====================================================================================*/
-
 #define CATCH_CONFIG_MAIN
 #include <catch2/catch_test_macros.hpp>
 
 #include "bits/stdc++.h"
+#include "dijkstra.h"
 using namespace std;
 
-vector<int> dijkstra(int n, vector<vector<int>> g[], int s) {
-  vector<int> dists(n, INT_MAX);
-  dists[s] = 0;
-
-  priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> pq;
-  pq.push({s, 0});
-
-  while(!pq.empty()) {
-    pair<int, int> curr = pq.top();
-    int node = curr.first;
-    int dist = curr.second;
-    pq.pop();
-
-    for (const auto& p : g[node]) {
-      int nbr = p[0];
-      int weight = p[1];
-
-      if (dist + weight < dists[nbr]) {
-        dists[nbr] = dist + weight;
-        pq.push({nbr, dists[nbr]});
-      }
-    }
-  }
-
-  return dists;
-}
-
 TEST_CASE("Dijkstra's algorithm test cases") {
     SECTION("Simple graph") {
         int n = 5;
@@ -100,3 +62,148 @@ TEST_CASE("Dijkstra's algorithm test cases") {
         REQUIRE(result == expected);
     }
 }
+
+TEST_CASE("Dijkstra's algorithm with templated types") {
+    SECTION("Narrow weights and vertex ids") {
+        using Edge = WeightedEdge<uint32_t, uint16_t>;
+        vector<Edge> g[5] = {
+            {{1, 2}, {3, 6}},
+            {{0, 2}, {2, 3}, {3, 8}, {4, 5}},
+            {{1, 3}, {4, 7}},
+            {{0, 6}, {1, 8}},
+            {{1, 5}, {2, 7}}
+        };
+        vector<uint64_t> expected = {0, 2, 5, 6, 7};
+        REQUIRE(dijkstra(5, g, 0u) == expected);
+        REQUIRE(sizeof(Edge) == 8);
+    }
+
+    SECTION("64-bit vertex ids") {
+        vector<WeightedEdge<int64_t, int>> g[3] = {
+            {{1, 4}},
+            {{2, 5}},
+            {}
+        };
+        vector<int64_t> expected = {0, 4, 9};
+        REQUIRE(dijkstra(3, g, int64_t(0)) == expected);
+    }
+
+    SECTION("Long paths saturate instead of overflowing") {
+        vector<WeightedEdge<int, int>> g[4] = {
+            {{1, INT_MAX - 1}},
+            {{2, INT_MAX - 1}},
+            {{3, 1}},
+            {}
+        };
+        vector<int> result = dijkstra<int, int, int>(4, g, 0);
+        vector<int> expected = {0, INT_MAX - 1, INT_MAX, INT_MAX};
+        REQUIRE(result == expected);
+
+        vector<int64_t> wide = dijkstra(4, g, 0);
+        REQUIRE(wide[3] == 2LL * (INT_MAX - 1) + 1);
+    }
+
+    SECTION("Floating point weights") {
+        vector<WeightedEdge<int, double>> g[3] = {
+            {{1, 0.5}, {2, 2.0}},
+            {{2, 0.25}},
+            {}
+        };
+        vector<double> expected = {0.0, 0.5, 0.75};
+        REQUIRE(dijkstra(3, g, 0) == expected);
+    }
+
+    SECTION("Radix heap, binary heap and d-ary heap agree") {
+        int n = 2000;
+        vector<vector<WeightedEdge<uint32_t, uint16_t>>> g(n);
+        vector<vector<vector<int>>> g_int(n);
+        mt19937 rng(3);
+        for (int i = 0; i < 10 * n; i++) {
+            uint32_t u = rng() % n, v = rng() % n;
+            uint16_t w = rng() % 60000;
+            g[u].push_back({v, w});
+            g_int[u].push_back({(int)v, (int)w});
+        }
+
+        auto radix = dijkstra<uint32_t, uint16_t, uint64_t, RadixHeapQueue<uint64_t, uint32_t>>(n, g.data(), 0u);
+        auto binary = dijkstra<uint32_t, uint16_t, uint64_t, BinaryHeapQueue<uint64_t, uint32_t>>(n, g.data(), 0u);
+        auto dary = dijkstra<uint32_t, uint16_t, uint64_t, DaryHeapQueue<uint64_t, uint32_t, 8>>(n, g.data(), 0u);
+        vector<int> reference = dijkstra(n, g_int.data(), 0);
+
+        REQUIRE(radix == binary);
+        REQUIRE(radix == dary);
+        for (int v = 0; v < n; v++) {
+            if (reference[v] == INT_MAX) REQUIRE(radix[v] == infinity<uint64_t>());
+            else REQUIRE(radix[v] == (uint64_t)reference[v]);
+        }
+    }
+}
+
+TEST_CASE("Dijkstra's algorithm with early stopping") {
+    // Path 0 - 1 - 2 - 3 - 4 with weights 1, 2, 3, 4, and a detour 0 - 4 of 20.
+    vector<WeightedEdge<int, int>> path[5] = {
+        {{1, 1}, {4, 20}},
+        {{0, 1}, {2, 2}},
+        {{1, 2}, {3, 3}},
+        {{2, 3}, {4, 4}},
+        {{3, 4}, {0, 20}}
+    };
+
+    SECTION("Bounded radius") {
+        vector<pair<int, int64_t>> expected = {{0, 0}, {1, 1}, {2, 3}, {3, 6}};
+        REQUIRE(dijkstra_within(path, 0, 6) == expected);
+        REQUIRE(dijkstra_within(path, 0, 5).size() == 3);
+        REQUIRE(dijkstra_within(path, 0, 0).size() == 1);
+    }
+
+    SECTION("k nearest targets") {
+        vector<pair<int, int64_t>> expected = {{3, 6}};
+        REQUIRE(dijkstra_k_targets(path, 0, vector<int>{4, 3}, 1) == expected);
+
+        expected = {{3, 6}, {4, 10}};
+        REQUIRE(dijkstra_k_targets(path, 0, vector<int>{4, 3}, 5) == expected);
+
+        // A radius can be combined with the target set.
+        expected = {};
+        REQUIRE(dijkstra_k_targets(path, 0, vector<int>{4, 3}, 1, 5) == expected);
+    }
+
+    SECTION("k nearest matching a predicate") {
+        auto is_even = [](int v) { return v % 2 == 0; };
+        vector<pair<int, int64_t>> expected = {{0, 0}, {2, 3}};
+        REQUIRE(dijkstra_k_nearest(path, 0, 2, is_even) == expected);
+    }
+
+    SECTION("Agrees with the full search on a random graph") {
+        int n = 3000;
+        vector<vector<WeightedEdge<uint32_t, uint16_t>>> g(n);
+        mt19937 rng(11);
+        for (int i = 0; i < 4 * n; i++) {
+            uint32_t u = rng() % n, v = rng() % n;
+            uint16_t w = 1 + rng() % 100;
+            g[u].push_back({v, w});
+            g[v].push_back({u, w});
+        }
+        vector<uint64_t> full = dijkstra(n, g.data(), 0u);
+
+        uint64_t radius = 150;
+        auto within = dijkstra_within(g.data(), 0u, radius);
+        size_t n_within = count_if(full.begin(), full.end(), [&](uint64_t d) { return d <= radius; });
+        REQUIRE(within.size() == n_within);
+        for (size_t i = 0; i < within.size(); i++) {
+            REQUIRE(within[i].second == full[within[i].first]);
+            if (i > 0) REQUIRE(within[i - 1].second <= within[i].second);
+        }
+
+        auto nearest = dijkstra_k_nearest(g.data(), 0u, 10, [](uint32_t v) { return v % 7 == 0; });
+        REQUIRE(nearest.size() == 10);
+        uint64_t worst = nearest.back().second;
+        for (const auto& [v, d] : nearest) REQUIRE(d == full[v]);
+        for (int v = 0; v < n; v++) {
+            if (v % 7 == 0 && full[v] < worst) {
+                REQUIRE(find_if(nearest.begin(), nearest.end(),
+                                [&](const auto& p) { return (int)p.first == v; }) != nearest.end());
+            }
+        }
+    }
+}
@@ -0,0 +1,153 @@
+/* ====================================================================================
+   This file contains the implementation of the Dijkstra's algorithm using a priority
+   queue. It returns the shortest distance from the starting node to all other nodes.
+
+   There are two interfaces:
+     - dijkstra(int n, vector<vector<int>> g[], int s), where every g[u] entry is a
+       {neighbor, weight} pair of ints and unreachable nodes get INT_MAX.
+     - dijkstra<Vertex, Weight, Dist, Queue>(n, g, s), where g[u] is a
+       vector<WeightedEdge<Vertex, Weight>> (see shortest_path.h). Dist defaults
+       to a 64-bit type and Queue to a radix heap for unsigned distances, and
+       unreachable nodes get infinity<Dist>().
+   Both add weights with saturating_add(), so distances never overflow.
+
+   For queries that only care about the neighborhood of s, there are early-stopping
+   variants that keep tentative distances in a hash map instead of an n-sized vector
+   and return a sparse list of {vertex, distance} pairs, nearest first:
+     - dijkstra_within(g, s, radius):       every vertex at distance <= radius
+     - dijkstra_k_targets(g, s, targets, k): the k nearest vertices among targets
+     - dijkstra_k_nearest(g, s, k, pred):   the k nearest vertices v with pred(v)
+   Their cost depends on the part of the graph they settle, not on n.
+
+   @param n: the number of vertices in the graph
+   @param g: the adjacency list representation of the graph
+   @param s: the starting node
+   @return vector<int>: the shortest distance from the starting node to all other nodes
+
+   @author: Muhammad Fadli Alim Arsani
+=====================================================================================*/
+
+#ifndef DIJKSTRA_H
+#define DIJKSTRA_H
+
+#include "bits/stdc++.h"
+#include "shortest_path.h"
+
+// for_each_edge(u, f) calls f(v, w) for every edge u -> v with weight w.
+template <typename Dist, typename Queue, typename Vertex, typename ForEachEdge>
+std::vector<Dist> dijkstra_impl(Vertex n, Vertex s, ForEachEdge&& for_each_edge) {
+  std::vector<Dist> dists(n, infinity<Dist>());
+  dists[s] = 0;
+
+  Queue pq;
+  pq.push(Dist(0), s);
+
+  while (!pq.empty()) {
+    auto [dist, node] = pq.pop();
+
+    // Skip entries made stale by a later, shorter path to the same node.
+    if (dist > dists[node]) continue;
+
+    for_each_edge(node, [&](Vertex nbr, auto weight) {
+      Dist next = saturating_add(dist, weight);
+      if (next < dists[nbr]) {
+        dists[nbr] = next;
+        pq.push(next, nbr);
+      }
+    });
+  }
+
+  return dists;
+}
+
+template <typename Vertex, typename Weight, typename Dist = distance_t<Weight>,
+          typename Queue = default_queue_t<Dist, Vertex>>
+std::vector<Dist> dijkstra(std::type_identity_t<Vertex> n,
+                           const std::vector<WeightedEdge<Vertex, Weight>> g[], Vertex s) {
+  return dijkstra_impl<Dist, Queue>(n, s, [&](Vertex u, auto&& relax) {
+    for (const auto& edge : g[u]) relax(edge.to, edge.weight);
+  });
+}
+
+inline std::vector<int> dijkstra(int n, std::vector<std::vector<int>> g[], int s) {
+  return dijkstra_impl<int, DaryHeapQueue<int, int>>(n, s, [&](int u, auto&& relax) {
+    for (const auto& p : g[u]) relax(p[0], p[1]);
+  });
+}
+
+// Settles vertices in order of distance from s, ignoring paths longer than radius,
+// and calls settle(v, dist) for each of them until it returns false.
+template <typename Dist, typename Queue, typename Vertex, typename ForEachEdge, typename Settle>
+void dijkstra_search(Vertex s, Dist radius, ForEachEdge&& for_each_edge, Settle&& settle) {
+  std::unordered_map<Vertex, Dist> dists;
+  dists[s] = 0;
+
+  Queue pq;
+  pq.push(Dist(0), s);
+
+  while (!pq.empty()) {
+    auto [dist, node] = pq.pop();
+    if (dist > dists[node]) continue;
+
+    if (!settle(node, dist)) return;
+
+    for_each_edge(node, [&](Vertex nbr, auto weight) {
+      Dist next = saturating_add(dist, weight);
+      if (next > radius) return;
+
+      auto [it, inserted] = dists.try_emplace(nbr, next);
+      if (inserted || next < it->second) {
+        it->second = next;
+        pq.push(next, nbr);
+      }
+    });
+  }
+}
+
+template <typename Vertex, typename Weight, typename Dist = distance_t<Weight>,
+          typename Queue = default_queue_t<Dist, Vertex>>
+std::vector<std::pair<Vertex, Dist>> dijkstra_within(
+    const std::vector<WeightedEdge<Vertex, Weight>> g[], Vertex s,
+    std::type_identity_t<Dist> radius) {
+  std::vector<std::pair<Vertex, Dist>> result;
+  dijkstra_search<Dist, Queue>(s, radius, [&](Vertex u, auto&& relax) {
+    for (const auto& edge : g[u]) relax(edge.to, edge.weight);
+  }, [&](Vertex v, Dist dist) {
+    result.push_back({v, dist});
+    return true;
+  });
+  return result;
+}
+
+template <typename Vertex, typename Weight, typename Pred, typename Dist = distance_t<Weight>,
+          typename Queue = default_queue_t<Dist, Vertex>>
+std::vector<std::pair<Vertex, Dist>> dijkstra_k_nearest(
+    const std::vector<WeightedEdge<Vertex, Weight>> g[], Vertex s, std::size_t k, Pred pred,
+    std::type_identity_t<Dist> radius = infinity<Dist>()) {
+  std::vector<std::pair<Vertex, Dist>> result;
+  if (k == 0) return result;
+
+  dijkstra_search<Dist, Queue>(s, radius, [&](Vertex u, auto&& relax) {
+    for (const auto& edge : g[u]) relax(edge.to, edge.weight);
+  }, [&](Vertex v, Dist dist) {
+    if (pred(v)) result.push_back({v, dist});
+    return result.size() < k;
+  });
+  return result;
+}
+
+template <typename Vertex, typename Weight, typename Dist = distance_t<Weight>,
+          typename Queue = default_queue_t<Dist, Vertex>>
+std::vector<std::pair<Vertex, Dist>> dijkstra_k_targets(
+    const std::vector<WeightedEdge<Vertex, Weight>> g[], Vertex s,
+    const std::vector<Vertex>& targets, std::size_t k,
+    std::type_identity_t<Dist> radius = infinity<Dist>()) {
+  std::unordered_set<Vertex> is_target(targets.begin(), targets.end());
+  auto pred = [&](Vertex v) { return is_target.count(v) > 0; };
+
+  // Asking for more targets than there are would otherwise search the whole graph.
+  k = std::min(k, is_target.size());
+  return dijkstra_k_nearest<Vertex, Weight, decltype(pred), Dist, Queue>(g, s, k, pred, radius);
+}
+
+#endif // end of dijkstra.h definition
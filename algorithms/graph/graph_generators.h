@@ -0,0 +1,192 @@
+/* ==============================================================================
+   Seeded synthetic graph generators used by graph_bench.cpp. Every generator
+   returns a weighted edge list together with helpers that convert it into the
+   representations the algorithms in this directory take:
+     - adjacency():          std::vector<int> per vertex (bfs, dfs, kahn)
+     - weighted_adjacency(): {neighbor, weight} pairs per vertex (dijkstra, astar)
+     - edge_list():          {u, v, w} triples (bellman_ford)
+   Undirected graphs store every edge once and expand it in both directions.
+
+   The same seed always produces the same graph, so benchmark runs are
+   comparable across commits.
+===============================================================================*/
+
+#ifndef GRAPH_GENERATORS_H
+#define GRAPH_GENERATORS_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+struct GeneratedGraph {
+  std::string name;
+  int n = 0;
+  bool directed = false;
+  std::vector<std::array<int, 3>> edges; // {u, v, w}
+
+  /**
+   * @brief Get the number of directed edges the algorithms will see.
+   * @return The number of edges, counting undirected edges twice.
+   */
+  long long n_arcs() const {
+    return directed ? edges.size() : 2LL * edges.size();
+  }
+
+  std::vector<std::vector<int>> adjacency() const {
+    std::vector<std::vector<int>> adj(n);
+    for (const auto& [u, v, w] : edges) {
+      adj[u].push_back(v);
+      if (!directed) adj[v].push_back(u);
+    }
+    return adj;
+  }
+
+  std::vector<std::vector<std::vector<int>>> weighted_adjacency() const {
+    std::vector<std::vector<std::vector<int>>> g(n);
+    for (const auto& [u, v, w] : edges) {
+      g[u].push_back({v, w});
+      if (!directed) g[v].push_back({u, w});
+    }
+    return g;
+  }
+
+  std::vector<std::vector<int>> edge_list() const {
+    std::vector<std::vector<int>> e;
+    e.reserve(n_arcs());
+    for (const auto& [u, v, w] : edges) {
+      e.push_back({u, v, w});
+      if (!directed) e.push_back({v, u, w});
+    }
+    return e;
+  }
+};
+
+const int GENERATOR_MAX_WEIGHT = 100;
+
+/**
+ * @brief R-MAT (recursive matrix, a Kronecker graph) generator with the
+ *        Graph500 parameters. Produces a skewed, power-law degree distribution.
+ * @param scale The graph has 2^scale vertices.
+ * @param degree The average number of (undirected) edges per vertex.
+ * @param seed The random seed.
+ */
+inline GeneratedGraph rmat_graph(int scale, int degree, uint64_t seed,
+                                 double a = 0.57, double b = 0.19, double c = 0.19) {
+  GeneratedGraph graph;
+  graph.name = "rmat";
+  graph.n = 1 << scale;
+
+  std::mt19937_64 rng(seed);
+  std::uniform_real_distribution<double> coin(0.0, 1.0);
+  std::uniform_int_distribution<int> weight(1, GENERATOR_MAX_WEIGHT);
+
+  // Shuffle vertex ids so that high degree vertices are not clustered at low ids.
+  // Vertex 0 stays the hub, so traversals starting at 0 see the giant component.
+  std::vector<int> perm(graph.n);
+  std::iota(perm.begin(), perm.end(), 0);
+  std::shuffle(perm.begin() + 1, perm.end(), rng);
+
+  long long m = (long long)graph.n * degree;
+  graph.edges.reserve(m);
+  for (long long i = 0; i < m; i++) {
+    int u = 0, v = 0;
+    for (int bit = 0; bit < scale; bit++) {
+      double r = coin(rng);
+      if (r < a) {}
+      else if (r < a + b) v |= 1 << bit;
+      else if (r < a + b + c) u |= 1 << bit;
+      else { u |= 1 << bit; v |= 1 << bit; }
+    }
+    graph.edges.push_back({perm[u], perm[v], weight(rng)});
+  }
+  return graph;
+}
+
+/**
+ * @brief Road-like 2D grid: every cell is connected to its 4 neighbors with a
+ *        random travel time, and a fraction of the streets is removed.
+ * @param rows The number of grid rows.
+ * @param cols The number of grid columns. Vertex (r, c) has id r * cols + c.
+ * @param seed The random seed.
+ * @param drop The probability that a street is missing.
+ */
+inline GeneratedGraph grid_road_graph(int rows, int cols, uint64_t seed, double drop = 0.1) {
+  GeneratedGraph graph;
+  graph.name = "grid";
+  graph.n = rows * cols;
+
+  std::mt19937_64 rng(seed);
+  std::uniform_real_distribution<double> coin(0.0, 1.0);
+  std::uniform_int_distribution<int> weight(1, GENERATOR_MAX_WEIGHT);
+
+  graph.edges.reserve(2LL * graph.n);
+  for (int r = 0; r < rows; r++) {
+    for (int c = 0; c < cols; c++) {
+      int u = r * cols + c;
+      if (c + 1 < cols && coin(rng) >= drop) graph.edges.push_back({u, u + 1, weight(rng)});
+      if (r + 1 < rows && coin(rng) >= drop) graph.edges.push_back({u, u + cols, weight(rng)});
+    }
+  }
+  return graph;
+}
+
+/**
+ * @brief Erdos-Renyi G(n, m) graph: m edges with uniformly random endpoints.
+ * @param n The number of vertices.
+ * @param degree The average number of (undirected) edges per vertex.
+ * @param seed The random seed.
+ */
+inline GeneratedGraph erdos_renyi_graph(int n, int degree, uint64_t seed) {
+  GeneratedGraph graph;
+  graph.name = "er";
+  graph.n = n;
+
+  std::mt19937_64 rng(seed);
+  std::uniform_int_distribution<int> vertex(0, n - 1);
+  std::uniform_int_distribution<int> weight(1, GENERATOR_MAX_WEIGHT);
+
+  long long m = (long long)n * degree;
+  graph.edges.reserve(m);
+  for (long long i = 0; i < m; i++) {
+    graph.edges.push_back({vertex(rng), vertex(rng), weight(rng)});
+  }
+  return graph;
+}
+
+/**
+ * @brief Random DAG: edges only go from lower to higher rank in a random
+ *        permutation, so ids alone do not give away a topological order.
+ *        Vertex 0 always has rank 0 and reaches a large part of the graph.
+ * @param n The number of vertices.
+ * @param degree The average out-degree.
+ * @param seed The random seed.
+ */
+inline GeneratedGraph dag_graph(int n, int degree, uint64_t seed) {
+  GeneratedGraph graph;
+  graph.name = "dag";
+  graph.n = n;
+  graph.directed = true;
+
+  std::mt19937_64 rng(seed);
+  std::uniform_int_distribution<int> weight(1, GENERATOR_MAX_WEIGHT);
+
+  std::vector<int> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  std::shuffle(order.begin() + 1, order.end(), rng);
+
+  long long m = (long long)n * degree;
+  graph.edges.reserve(m);
+  for (long long i = 0; i < m && n > 1; i++) {
+    int a = rng() % n, b = rng() % n;
+    if (a == b) continue;
+    if (a > b) std::swap(a, b);
+    graph.edges.push_back({order[a], order[b], weight(rng)});
+  }
+  return graph;
+}
+
+#endif // end of graph_generators.h definition
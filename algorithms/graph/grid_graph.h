@@ -0,0 +1,106 @@
+/* ==============================================================================
+   This is an implicit graph over a 2D occupancy grid. Cells are vertices with
+   id y * width + x, blocked cells are stored in a bitmap (one bit per cell),
+   and neighbors are computed from coordinates on the fly, so no edge is ever
+   stored. A 4096 x 4096 map takes 2 MB instead of the hundreds of MB needed
+   by an explicit adjacency list with 8 neighbor entries per cell.
+
+   Two movement models are supported:
+     - GridMoves::Four:  up/down/left/right with cost 1 (Manhattan heuristic)
+     - GridMoves::Eight: also diagonals with cost sqrt(2) (octile heuristic).
+                         A diagonal step is only allowed when both cells it
+                         squeezes between are free, so paths never cut corners.
+
+   See astar.h for the A* and Jump Point Search specialization.
+
+   @param width:  the number of columns
+   @param height: the number of rows
+   @param moves:  the movement model
+===============================================================================*/
+
+#ifndef GRID_GRAPH_H
+#define GRID_GRAPH_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+enum class GridMoves { Four, Eight };
+
+class GridGraph {
+  public:
+    GridGraph(int width, int height, GridMoves moves = GridMoves::Eight)
+        : w(width), h(height), moves(moves),
+          bits((static_cast<std::size_t>(width) * height + 63) / 64, 0) {}
+
+    int width() const { return w; }
+    int height() const { return h; }
+    int size() const { return w * h; }
+    GridMoves movement() const { return moves; }
+
+    int id(int x, int y) const { return y * w + x; }
+    int x_of(int v) const { return v % w; }
+    int y_of(int v) const { return v / w; }
+
+    /**
+     * @brief Check whether a cell can be entered.
+     * @return False for blocked cells and for coordinates outside the grid.
+     */
+    bool free(int x, int y) const {
+      if (x < 0 || y < 0 || x >= w || y >= h) return false;
+      std::size_t i = static_cast<std::size_t>(y) * w + x;
+      return !((bits[i >> 6] >> (i & 63)) & 1);
+    }
+
+    void set_blocked(int x, int y, bool blocked = true) {
+      std::size_t i = static_cast<std::size_t>(y) * w + x;
+      if (blocked) bits[i >> 6] |= uint64_t(1) << (i & 63);
+      else bits[i >> 6] &= ~(uint64_t(1) << (i & 63));
+    }
+
+    /**
+     * @brief Call f(neighbor, cost) for every cell reachable from v in one step.
+     * @param v The cell id.
+     * @param f The callback.
+     */
+    template <typename F>
+    void for_each_neighbor(int v, F&& f) const {
+      int x = x_of(v), y = y_of(v);
+      bool left = free(x - 1, y), right = free(x + 1, y);
+      bool up = free(x, y - 1), down = free(x, y + 1);
+
+      if (left) f(v - 1, 1.0);
+      if (right) f(v + 1, 1.0);
+      if (up) f(v - w, 1.0);
+      if (down) f(v + w, 1.0);
+      if (moves == GridMoves::Four) return;
+
+      if (left && up && free(x - 1, y - 1)) f(v - w - 1, SQRT2);
+      if (right && up && free(x + 1, y - 1)) f(v - w + 1, SQRT2);
+      if (left && down && free(x - 1, y + 1)) f(v + w - 1, SQRT2);
+      if (right && down && free(x + 1, y + 1)) f(v + w + 1, SQRT2);
+    }
+
+    /**
+     * @brief Exact distance between two cells on an empty grid: Manhattan for
+     *        GridMoves::Four, octile for GridMoves::Eight. Admissible and
+     *        consistent, so it can be used directly as the A* heuristic.
+     */
+    double distance(int u, int v) const {
+      int dx = std::abs(x_of(u) - x_of(v));
+      int dy = std::abs(y_of(u) - y_of(v));
+      if (moves == GridMoves::Four) return dx + dy;
+      return std::max(dx, dy) + (SQRT2 - 1.0) * std::min(dx, dy);
+    }
+
+    static constexpr double SQRT2 = 1.4142135623730951;
+
+  private:
+    int w, h;
+    GridMoves moves;
+    std::vector<uint64_t> bits;
+};
+
+#endif // end of grid_graph.h definition
@@ -1,48 +1,10 @@
-/*
-The advantage of using Kahn's technique besides generating topological sort
-is that it also aids in the discovery of graph cycles. The Kahn's method
-will never allow visiting any node in a cycle. So if you run the algorithm
-on a graph with a cycle, the algorithm will not be able to visit all the
-nodes in the graph. The result will be less than the total number of nodes
-in the graph.
-*/
-
 #define CATCH_CONFIG_MAIN
 #include <catch2/catch_test_macros.hpp>
 
 #include "bits/stdc++.h"
+#include "kahn.h"
 using namespace std;
 
-vector<int> kahn(int n, vector<int> adj_list[]) {
-  vector<int> in_degree(n, 0);
-  for (int i = 0; i < n; i++) {
-    for (const auto& j : adj_list[i]) {
-      in_degree[j]++;
-    }
-  }
-
-  queue<int> q;
-  for (int i = 0; i < n; i++) {
-    if (in_degree[i] == 0) {
-      q.push(i);
-    }
-  }
-
-  vector<int> topo_sort;
-  while (!q.empty()) {
-    int node = q.front();
-    q.pop();
-    topo_sort.push_back(node);
-
-    for (const auto& i : adj_list[node]) {
-      in_degree[i]--;
-      if (in_degree[i] == 0) q.push(i);
-    }
-  }
-
-  return topo_sort;
-}
-
 TEST_CASE("Kahn's Algorithm: Basic Tests") {
     SECTION("Single node graph") {
         vector<int> adj_list[1];
@@ -136,3 +98,43 @@ TEST_CASE("Kahn's Algorithm: Complex Graphs") {
         REQUIRE(result.size() < 4);
     }
 }
+
+TEST_CASE("Kahn's Algorithm: Compressed Graphs") {
+    SECTION("Graph with multiple edges and nodes") {
+        vector<int> adj_list[6];
+        adj_list[0].push_back(3);
+        adj_list[1].push_back(4);
+        adj_list[1].push_back(3);
+        adj_list[2].push_back(4);
+        adj_list[3].push_back(5);
+        adj_list[4].push_back(5);
+        CompressedGraph g(6, adj_list);
+        vector<int> result = kahn(g);
+        vector<int> expected = {0, 1, 2, 3, 4, 5};
+        REQUIRE(result == expected);
+    }
+
+    SECTION("Graph with cycle detection") {
+        vector<int> adj_list[4];
+        adj_list[0].push_back(1);
+        adj_list[1].push_back(2);
+        adj_list[2].push_back(3);
+        adj_list[3].push_back(1);
+        CompressedGraph g(4, adj_list);
+        vector<int> result = kahn(g);
+        REQUIRE(result.size() < 4);
+    }
+
+    SECTION("Same order as the adjacency list version on sorted lists") {
+        int n = 200;
+        vector<int> adj_list[200];
+        mt19937 rng(7);
+        for (int u = 0; u < n; u++) {
+            for (int v = u + 1; v < n; v++) {
+                if (rng() % 10 == 0) adj_list[u].push_back(v);
+            }
+        }
+        CompressedGraph g(n, adj_list);
+        REQUIRE(kahn(g) == kahn(n, adj_list));
+    }
+}
@@ -0,0 +1,81 @@
+/*
+The advantage of using Kahn's technique besides generating topological sort
+is that it also aids in the discovery of graph cycles. The Kahn's method
+will never allow visiting any node in a cycle. So if you run the algorithm
+on a graph with a cycle, the algorithm will not be able to visit all the
+nodes in the graph. The result will be less than the total number of nodes
+in the graph.
+
+There is also an overload taking a CompressedGraph (see compressed_graph.h),
+which decodes each gap-encoded adjacency list while relaxing in-degrees
+instead of reading it from a std::vector<int>.
+*/
+
+#ifndef KAHN_H
+#define KAHN_H
+
+#include "bits/stdc++.h"
+#include "compressed_graph.h"
+
+inline std::vector<int> kahn(int n, std::vector<int> adj_list[]) {
+  std::vector<int> in_degree(n, 0);
+  for (int i = 0; i < n; i++) {
+    for (const auto& j : adj_list[i]) {
+      in_degree[j]++;
+    }
+  }
+
+  std::queue<int> q;
+  for (int i = 0; i < n; i++) {
+    if (in_degree[i] == 0) {
+      q.push(i);
+    }
+  }
+
+  std::vector<int> topo_sort;
+  while (!q.empty()) {
+    int node = q.front();
+    q.pop();
+    topo_sort.push_back(node);
+
+    for (const auto& i : adj_list[node]) {
+      in_degree[i]--;
+      if (in_degree[i] == 0) q.push(i);
+    }
+  }
+
+  return topo_sort;
+}
+
+inline std::vector<int> kahn(const CompressedGraph& g) {
+  int n = g.size();
+  std::vector<int> in_degree(n, 0);
+  for (int i = 0; i < n; i++) {
+    g.for_each_neighbor(i, [&](int j) {
+      in_degree[j]++;
+    });
+  }
+
+  std::queue<int> q;
+  for (int i = 0; i < n; i++) {
+    if (in_degree[i] == 0) {
+      q.push(i);
+    }
+  }
+
+  std::vector<int> topo_sort;
+  while (!q.empty()) {
+    int node = q.front();
+    q.pop();
+    topo_sort.push_back(node);
+
+    g.for_each_neighbor(node, [&](int i) {
+      in_degree[i]--;
+      if (in_degree[i] == 0) q.push(i);
+    });
+  }
+
+  return topo_sort;
+}
+
+#endif // end of kahn.h definition
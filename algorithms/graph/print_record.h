@@ -0,0 +1,28 @@
+/* ==============================================================================
+   Prints the order in which a traversal (bfs.h, dfs.h) visited the vertices,
+   as a list: [0, 2, 1].
+
+   @param record: the visited vertices, in order
+
+   @author: Muhammad Fadli Alim Arsani
+===============================================================================*/
+
+#ifndef PRINT_RECORD_H
+#define PRINT_RECORD_H
+
+#include "bits/stdc++.h"
+
+inline void print_record(const std::vector<int>& record) {
+  std::cout << "[";
+  for (size_t i = 0; i < record.size(); i++) {
+    if (i == record.size() - 1) {
+      std::cout << record[i];
+    }
+    else {
+      std::cout << record[i] << ", ";
+    }
+  }
+  std::cout << "]" << std::endl;
+}
+
+#endif // end of print_record.h definition
@@ -0,0 +1,189 @@
+/* ==============================================================================
+   Common building blocks for the templated shortest path algorithms in
+   dijkstra.h, astar.h and bellman_ford.h.
+
+   - WeightedEdge<Vertex, Weight>: an adjacency list entry {to, weight}
+   - WeightedArc<Vertex, Weight>:  an edge list entry {from, to, weight}
+   - infinity<Dist>():             the distance of an unreachable vertex
+   - saturating_add(dist, weight): dist + weight clamped to the range of Dist,
+                                   so long paths saturate at infinity instead of
+                                   wrapping around to small (or negative) values
+   - distance_t<Weight>:           the default distance type, wide enough that
+                                   sums of narrow weights do not saturate
+   - BinaryHeapQueue / DaryHeapQueue / RadixHeapQueue and
+     default_queue_t<Dist, Vertex>, which picks the queue at compile time: a
+     radix heap for unsigned integer distances (dijkstra pops keys in
+     nondecreasing order, which is all a radix heap needs), a 4-ary heap
+     otherwise.
+
+   Narrow types matter: WeightedEdge<uint32_t, uint16_t> is 8 bytes, while the
+   `std::vector<int>` per edge used by the int overloads costs a heap block of
+   its own plus a 24 byte header.
+===============================================================================*/
+
+#ifndef SHORTEST_PATH_H
+#define SHORTEST_PATH_H
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../sorting/heap.h"
+
+template <typename Vertex, typename Weight>
+struct WeightedEdge {
+  Vertex to;
+  Weight weight;
+};
+
+template <typename Vertex, typename Weight>
+struct WeightedArc {
+  Vertex from;
+  Vertex to;
+  Weight weight;
+};
+
+template <typename Weight>
+using distance_t = std::conditional_t<
+    std::is_floating_point_v<Weight>, Weight,
+    std::conditional_t<std::is_signed_v<Weight>, int64_t, uint64_t>>;
+
+template <typename Dist>
+constexpr Dist infinity() {
+  return std::numeric_limits<Dist>::max();
+}
+
+/**
+ * @brief Add a weight to a distance without overflowing.
+ * @param dist A distance, possibly infinity<Dist>().
+ * @param weight An edge weight.
+ * @return dist + weight, infinity<Dist>() if dist is infinite or the sum is too
+ *         large, and the lowest value of Dist if the sum is too small.
+ */
+template <typename Dist, typename Weight>
+constexpr Dist saturating_add(Dist dist, Weight weight) {
+  if (dist == infinity<Dist>()) {
+    return dist;
+  }
+
+  if constexpr (std::is_integral_v<Dist> && std::is_integral_v<Weight>) {
+    Dist sum;
+    if (__builtin_add_overflow(dist, weight, &sum)) {
+      return weight < 0 ? std::numeric_limits<Dist>::lowest() : infinity<Dist>();
+    }
+    return sum;
+  }
+  else {
+    Dist sum = dist + static_cast<Dist>(weight);
+    return sum > infinity<Dist>() ? infinity<Dist>() : sum;
+  }
+}
+
+// std::priority_queue ordered by distance, smallest first.
+template <typename Dist, typename Vertex>
+class BinaryHeapQueue {
+  public:
+    bool empty() const {
+      return pq.empty();
+    }
+
+    void push(Dist key, Vertex v) {
+      pq.push({key, v});
+    }
+
+    std::pair<Dist, Vertex> pop() {
+      std::pair<Dist, Vertex> top = pq.top();
+      pq.pop();
+      return top;
+    }
+
+  private:
+    std::priority_queue<std::pair<Dist, Vertex>, std::vector<std::pair<Dist, Vertex>>,
+                        std::greater<std::pair<Dist, Vertex>>> pq;
+};
+
+// Monotone priority queue for unsigned integer keys: every pushed key must be
+// at least the last popped key. Entries sit in the bucket given by the highest
+// bit in which they differ from the last popped key, so each entry moves at
+// most once per bit of Dist and push is a plain vector append.
+template <typename Dist, typename Vertex>
+class RadixHeapQueue {
+  static_assert(std::is_integral_v<Dist> && std::is_unsigned_v<Dist>,
+                "RadixHeapQueue needs unsigned integer keys");
+
+  public:
+    bool empty() const {
+      return n_entries == 0;
+    }
+
+    void push(Dist key, Vertex v) {
+      buckets[bucket_of(key)].push_back({key, v});
+      n_entries++;
+    }
+
+    std::pair<Dist, Vertex> pop() {
+      if (buckets[0].empty()) {
+        int i = 1;
+        while (buckets[i].empty()) i++;
+
+        last = buckets[i][0].first;
+        for (const auto& entry : buckets[i]) {
+          if (entry.first < last) last = entry.first;
+        }
+        for (const auto& entry : buckets[i]) {
+          buckets[bucket_of(entry.first)].push_back(entry);
+        }
+        buckets[i].clear();
+      }
+
+      std::pair<Dist, Vertex> top = buckets[0].back();
+      buckets[0].pop_back();
+      n_entries--;
+      return top;
+    }
+
+  private:
+    static constexpr int BITS = std::numeric_limits<Dist>::digits;
+
+    std::array<std::vector<std::pair<Dist, Vertex>>, BITS + 1> buckets;
+    Dist last = 0;
+    std::size_t n_entries = 0;
+
+    int bucket_of(Dist key) const {
+      return std::bit_width(static_cast<Dist>(key ^ last));
+    }
+};
+
+// 4-ary heap ordered by distance, smallest first (see sorting/heap.h). Pops do
+// about half the comparisons and cache misses of BinaryHeapQueue.
+template <typename Dist, typename Vertex, int D = 4>
+class DaryHeapQueue {
+  public:
+    bool empty() const {
+      return pq.empty();
+    }
+
+    void push(Dist key, Vertex v) {
+      pq.emplace(key, v);
+    }
+
+    std::pair<Dist, Vertex> pop() {
+      return pq.extract();
+    }
+
+  private:
+    DaryHeap<std::pair<Dist, Vertex>, D, std::greater<std::pair<Dist, Vertex>>> pq;
+};
+
+template <typename Dist, typename Vertex>
+using default_queue_t = std::conditional_t<
+    std::is_integral_v<Dist> && std::is_unsigned_v<Dist>,
+    RadixHeapQueue<Dist, Vertex>, DaryHeapQueue<Dist, Vertex>>;
+
+#endif // end of shortest_path.h definition
@@ -0,0 +1,153 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_test_macros.hpp>
+
+#include "bits/stdc++.h"
+#include "external_sort.h"
+#include "test_util.h"
+using namespace std;
+
+
+string temp_path(const string& name) {
+  return (filesystem::temp_directory_path() / ("external_sort_test_" + name)).string();
+}
+
+void write_ints(const string& path, const vector<int>& arr) {
+  ofstream out(path, ios::binary);
+  out.write(reinterpret_cast<const char*>(arr.data()), arr.size() * sizeof(int));
+}
+
+vector<int> read_ints(const string& path) {
+  vector<int> arr(filesystem::file_size(path) / sizeof(int));
+  ifstream in(path, ios::binary);
+  in.read(reinterpret_cast<char*>(arr.data()), arr.size() * sizeof(int));
+  return arr;
+}
+
+// Number of files in dir that external_sort() left behind.
+int leftover_runs(const string& dir) {
+  int count = 0;
+  for (const auto& entry : filesystem::directory_iterator(dir)) {
+    if (entry.path().extension() == ".run") count++;
+  }
+  return count;
+}
+
+TEST_CASE("LoserTree function") {
+  vector<vector<int>> runs = {{1, 4, 9}, {}, {2, 3, 10, 11}, {0}, {4, 4}};
+  vector<size_t> pos(runs.size(), 0);
+
+  LoserTree tree(runs.size());
+  for (size_t i = 0; i < runs.size(); i++) {
+    if (!runs[i].empty()) tree.set(i, runs[i][0]);
+  }
+  tree.build();
+
+  vector<int> merged;
+  while (!tree.empty()) {
+    int w = tree.winner();
+    merged.push_back(tree.top());
+    if (++pos[w] == runs[w].size()) tree.set_done(w);
+    else tree.set(w, runs[w][pos[w]]);
+    tree.replay();
+  }
+  REQUIRE(merged == vector<int>{0, 1, 2, 3, 4, 4, 4, 9, 10, 11});
+
+  LoserTree single(1);
+  single.set(0, 7);
+  single.build();
+  REQUIRE(single.top() == 7);
+  single.set_done(0);
+  single.replay();
+  REQUIRE(single.empty());
+}
+
+TEST_CASE("external_sort function") {
+  string dir = temp_path("runs");
+  filesystem::create_directories(dir);
+  string input = temp_path("input.bin"), output = temp_path("output.bin");
+
+  ExternalSortOptions options;
+  options.temp_dir = dir;
+  options.n_threads = 2;
+
+  SECTION("fits in memory") {
+    vector<int> arr = {3, -1, 2, INT_MAX, INT_MIN, 0};
+    write_ints(input, arr);
+    external_sort(input, output, options);
+    REQUIRE(read_ints(output) == vector<int>{INT_MIN, -1, 0, 2, 3, INT_MAX});
+  }
+
+  SECTION("empty file") {
+    write_ints(input, {});
+    external_sort(input, output, options);
+    REQUIRE(read_ints(output).empty());
+  }
+
+  SECTION("many runs and merge passes") {
+    // 8 KB of memory: runs of 1024 ints and a fan-in of 2, with 4 KB buffers, or
+    // smaller ones with double buffering, so 300000 ints take 293 runs and 9
+    // merge passes.
+    for (bool async_io : {true, false}) {
+      vector<int> arr = random_array(300000, 0, 1000000, 1);
+      for (int i = 0; i < 100; i++) arr[i * 7] = INT_MIN + i % 3;
+      write_ints(input, arr);
+
+      options.memory_bytes = 8 << 10;
+      options.buffer_bytes = 4 << 10;
+      options.async_io = async_io;
+      external_sort(input, output, options);
+
+      std::sort(arr.begin(), arr.end());
+      REQUIRE(read_ints(output) == arr);
+    }
+  }
+
+  SECTION("wide merge and sorting in place") {
+    vector<int> arr = random_array(200000, 0, 50, 2);
+    write_ints(input, arr);
+
+    options.memory_bytes = 64 << 10;
+    options.buffer_bytes = 4 << 10;
+    external_sort(input, input, options);
+
+    std::sort(arr.begin(), arr.end());
+    REQUIRE(read_ints(input) == arr);
+  }
+
+  SECTION("memory budget smaller than the buffers") {
+    options.memory_bytes = 8 << 10;
+    options.buffer_bytes = 16 << 10;
+    for (bool async_io : {true, false}) {
+      options.async_io = async_io;
+      ExternalMergePlan plan = plan_external_merge(options);
+      size_t buffers = (plan.fan_in + 1) * (async_io ? 2 : 1);
+      REQUIRE(plan.fan_in == 2);
+      REQUIRE(buffers * plan.buffer_ints * sizeof(int) <= options.memory_bytes);
+      REQUIRE(plan.buffer_ints >= (async_io ? 341u : 682u));
+
+      vector<int> arr = random_array(20000, 0, 1000000, 3);
+      write_ints(input, arr);
+      external_sort(input, output, options);
+      std::sort(arr.begin(), arr.end());
+      REQUIRE(read_ints(output) == arr);
+    }
+
+    // A larger budget keeps buffer_bytes and widens the merge instead.
+    options.memory_bytes = 64 << 10;
+    options.buffer_bytes = 4 << 10;
+    options.async_io = true;
+    ExternalMergePlan plan = plan_external_merge(options);
+    REQUIRE(plan.fan_in == 7);
+    REQUIRE(plan.buffer_ints == 1024);
+  }
+
+  SECTION("input that is not a whole number of ints") {
+    ofstream(input, ios::binary) << "abc";
+    REQUIRE_THROWS_AS(external_sort(input, output, options), runtime_error);
+  }
+
+  REQUIRE(leftover_runs(dir) == 0);
+  filesystem::remove_all(dir);
+  filesystem::remove(input);
+  filesystem::remove(output);
+}
@@ -0,0 +1,377 @@
+/* ====================================================================================
+   This file contains an external merge sort for files of ints that do not fit in
+   memory. The input and output are raw arrays of native-endian 32-bit ints.
+
+   1. Run formation: the input is read in chunks of memory_bytes / 8 ints (half of
+      the budget, parallel_sort() needs a scratch buffer of the same size), each
+      chunk is sorted with parallel_sort() and written to a temporary run file.
+   2. Merging: up to fan_in runs are merged at a time with a loser tree. After the
+      first tournament, each output element costs one comparison per tree level
+      (log2(k)), half of what a binary heap needs. If there are more runs than
+      fan_in, groups of runs are merged into longer runs first, so every element
+      is read and written once per pass.
+
+   All file I/O is sequential, in buffers of buffer_bytes. With async_io, every run
+   reader and the output writer have two buffers: a background task fills (or
+   drains) one while the merge works on the other, so reading, merging and writing
+   overlap. fan_in is picked so that all buffers fit in memory_bytes; if the budget
+   cannot hold the buffers of a 2-way merge, the buffers are made smaller.
+
+   Temporary files go to temp_dir and are removed when the sort finishes or fails.
+   I/O errors throw std::runtime_error.
+
+   @param input_path:  the file to sort
+   @param output_path: where to write the sorted file (may equal input_path)
+   @param options:     memory budget, buffer size, threads, temp_dir, async_io
+=====================================================================================*/
+
+#ifndef EXTERNAL_SORT_H
+#define EXTERNAL_SORT_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "parallel_sort.h"
+
+struct ExternalSortOptions {
+  std::size_t memory_bytes = std::size_t(1) << 30;
+  std::size_t buffer_bytes = std::size_t(4) << 20;
+  int n_threads = 0;         // hardware_concurrency() if <= 0
+  std::string temp_dir;      // std::filesystem::temp_directory_path() if empty
+  bool async_io = true;
+};
+
+// A tournament tree over k sources. Internal node i stores the index of the source
+// that lost the match at i, and winner() is the source with the smallest key.
+// Exhausted sources lose to every other source.
+class LoserTree {
+  public:
+    explicit LoserTree(int k) : k(k), losers(k, -1), keys(k), done(k, true) {}
+
+    void set(int i, int key) {
+      keys[i] = key;
+      done[i] = false;
+    }
+
+    void set_done(int i) {
+      done[i] = true;
+    }
+
+    // Plays the whole tournament. Call after setting every source.
+    void build() {
+      std::vector<int> winners(2 * k);
+      for (int i = 0; i < k; i++) winners[k + i] = i;
+      for (int node = k - 1; node >= 1; node--) {
+        int a = winners[2 * node], b = winners[2 * node + 1];
+        winners[node] = beats(a, b) ? a : b;
+        losers[node] = beats(a, b) ? b : a;
+      }
+      win = k == 1 ? 0 : winners[1];
+    }
+
+    // Replays the matches on the path of the winner, after its key changed.
+    void replay() {
+      int w = win;
+      for (int node = (w + k) / 2; node >= 1; node /= 2) {
+        if (beats(losers[node], w)) std::swap(losers[node], w);
+      }
+      win = w;
+    }
+
+    int winner() const { return win; }
+    bool empty() const { return done[win]; }
+    int top() const { return keys[win]; }
+
+  private:
+    int k;
+    int win = 0;
+    std::vector<int> losers;
+    std::vector<int> keys;
+    std::vector<char> done;
+
+    bool beats(int a, int b) const {
+      if (done[a] != done[b]) return !done[a];
+      return keys[a] < keys[b] || (keys[a] == keys[b] && a < b);
+    }
+};
+
+inline std::FILE* open_file(const std::string& path, const char* mode) {
+  std::FILE* file = std::fopen(path.c_str(), mode);
+  if (!file) throw std::runtime_error("external_sort: cannot open " + path);
+  return file;
+}
+
+// Reads the ints of a file sequentially, one buffer at a time.
+class RunReader {
+  public:
+    RunReader(const std::string& path, std::size_t buffer_ints, bool async_io)
+        : file(open_file(path, "rb")), async_io(async_io),
+          current(buffer_ints), next(buffer_ints) {
+      len = read(current);
+      if (async_io && len > 0) prefetch();
+    }
+
+    ~RunReader() {
+      if (pending.valid()) pending.wait();
+      std::fclose(file);
+    }
+
+    RunReader(const RunReader&) = delete;
+    RunReader& operator=(const RunReader&) = delete;
+
+    bool empty() const { return pos == len; }
+    int front() const { return current[pos]; }
+
+    void pop() {
+      if (++pos == len) refill();
+    }
+
+    // Reads n ints straight into out, bypassing the buffers.
+    void read_exactly(int* out, std::size_t n) {
+      if (std::fread(out, sizeof(int), n, file) != n) {
+        throw std::runtime_error("external_sort: read error");
+      }
+    }
+
+  private:
+    std::FILE* file;
+    bool async_io;
+    std::vector<int> current, next;
+    std::size_t pos = 0, len = 0;
+    std::future<std::size_t> pending;
+
+    std::size_t read(std::vector<int>& buffer) {
+      std::size_t n = std::fread(buffer.data(), sizeof(int), buffer.size(), file);
+      if (n < buffer.size() && std::ferror(file)) {
+        throw std::runtime_error("external_sort: read error");
+      }
+      return n;
+    }
+
+    void prefetch() {
+      pending = std::async(std::launch::async, [this] { return read(next); });
+    }
+
+    void refill() {
+      pos = 0;
+      if (!async_io) {
+        len = read(current);
+        return;
+      }
+      if (!pending.valid()) {
+        len = 0;
+        return;
+      }
+      len = pending.get();
+      std::swap(current, next);
+      if (len > 0) prefetch();
+    }
+};
+
+// Writes ints to a file sequentially, one buffer at a time.
+class RunWriter {
+  public:
+    RunWriter(const std::string& path, std::size_t buffer_ints, bool async_io)
+        : file(open_file(path, "wb")), async_io(async_io) {
+      current.reserve(buffer_ints);
+      next.reserve(buffer_ints);
+    }
+
+    ~RunWriter() {
+      if (pending.valid()) pending.wait();
+      if (file) std::fclose(file);
+    }
+
+    RunWriter(const RunWriter&) = delete;
+    RunWriter& operator=(const RunWriter&) = delete;
+
+    void push(int x) {
+      current.push_back(x);
+      if (current.size() == current.capacity()) flush();
+    }
+
+    void write(const int* data, std::size_t n) {
+      if (std::fwrite(data, sizeof(int), n, file) != n) {
+        throw std::runtime_error("external_sort: write error");
+      }
+    }
+
+    void close() {
+      flush();
+      if (pending.valid()) pending.get();
+      if (std::fclose(file) != 0) {
+        file = nullptr;
+        throw std::runtime_error("external_sort: write error");
+      }
+      file = nullptr;
+    }
+
+  private:
+    std::FILE* file;
+    bool async_io;
+    std::vector<int> current, next;
+    std::future<void> pending;
+
+    void flush() {
+      if (current.empty()) return;
+      if (!async_io) {
+        write(current.data(), current.size());
+        current.clear();
+        return;
+      }
+
+      // Wait for the previous write, then hand this buffer to a new one.
+      if (pending.valid()) pending.get();
+      std::swap(current, next);
+      current.clear();
+      pending = std::async(std::launch::async, [this] { write(next.data(), next.size()); });
+    }
+};
+
+// Deletes the temporary files it was given when it goes out of scope.
+class TempFiles {
+  public:
+    explicit TempFiles(std::string dir) : dir(std::move(dir)) {
+      if (this->dir.empty()) this->dir = std::filesystem::temp_directory_path().string();
+      std::random_device rd;
+      prefix = "external_sort_" + std::to_string(rd()) + "_" + std::to_string(rd()) + "_";
+    }
+
+    ~TempFiles() {
+      std::error_code ec;
+      for (const auto& path : paths) std::filesystem::remove(path, ec);
+    }
+
+    std::string create() {
+      paths.push_back((std::filesystem::path(dir) / (prefix + std::to_string(paths.size()) + ".run")).string());
+      return paths.back();
+    }
+
+    void remove(const std::string& path) {
+      std::error_code ec;
+      std::filesystem::remove(path, ec);
+    }
+
+  private:
+    std::string dir;
+    std::string prefix;
+    std::vector<std::string> paths;
+};
+
+/**
+ * @brief Merge sorted run files into one sorted file with a loser tree.
+ */
+inline void merge_runs(const std::vector<std::string>& runs, const std::string& output_path,
+                       std::size_t buffer_ints, bool async_io) {
+  std::vector<std::unique_ptr<RunReader>> readers;
+  for (const auto& run : runs) {
+    readers.push_back(std::make_unique<RunReader>(run, buffer_ints, async_io));
+  }
+  RunWriter out(output_path, buffer_ints, async_io);
+
+  int k = readers.size();
+  LoserTree tree(k);
+  for (int i = 0; i < k; i++) {
+    if (!readers[i]->empty()) tree.set(i, readers[i]->front());
+  }
+  tree.build();
+
+  while (!tree.empty()) {
+    int w = tree.winner();
+    out.push(tree.top());
+
+    RunReader& reader = *readers[w];
+    reader.pop();
+    if (reader.empty()) tree.set_done(w);
+    else tree.set(w, reader.front());
+    tree.replay();
+  }
+
+  out.close();
+}
+
+struct ExternalMergePlan {
+  std::size_t fan_in;
+  std::size_t buffer_ints;
+};
+
+// Picks the fan-in and the buffer size of the merge passes. Every run reader and
+// the writer hold one buffer, two with async_io, and all of them must fit in
+// memory_bytes. A merge needs at least 2 readers, so when even 3 streams of
+// buffer_bytes do not fit, the buffers shrink instead (to no less than one int).
+inline ExternalMergePlan plan_external_merge(const ExternalSortOptions& options) {
+  std::size_t buffers_per_stream = options.async_io ? 2 : 1;
+  std::size_t buffer_ints = std::max<std::size_t>(1, options.buffer_bytes / sizeof(int));
+  std::size_t streams = options.memory_bytes / (buffers_per_stream * buffer_ints * sizeof(int));
+  if (streams >= 3) return {streams - 1, buffer_ints};
+
+  std::size_t shrunk = options.memory_bytes / (3 * buffers_per_stream * sizeof(int));
+  return {2, std::max<std::size_t>(1, std::min(buffer_ints, shrunk))};
+}
+
+inline void external_sort(const std::string& input_path, const std::string& output_path,
+                          const ExternalSortOptions& options = ExternalSortOptions()) {
+  std::uintmax_t file_bytes = std::filesystem::file_size(input_path);
+  if (file_bytes % sizeof(int) != 0) {
+    throw std::runtime_error("external_sort: " + input_path + " is not a whole number of ints");
+  }
+
+  std::size_t chunk_ints = std::max<std::size_t>(1024, options.memory_bytes / (2 * sizeof(int)));
+  ExternalMergePlan plan = plan_external_merge(options);
+  WorkStealingPool pool(options.n_threads);
+  TempFiles temp(options.temp_dir);
+
+  // 1. Sorted runs. If everything fits in one chunk, that run is the output.
+  std::uintmax_t total = file_bytes / sizeof(int);
+  std::vector<std::string> runs;
+  {
+    RunReader input(input_path, 0, false);
+    std::vector<int> chunk;
+
+    std::uintmax_t done = 0;
+    do {
+      std::size_t n = std::min<std::uintmax_t>(chunk_ints, total - done);
+      chunk.resize(n);
+      input.read_exactly(chunk.data(), n);
+      parallel_sort(chunk, pool);
+      done += n;
+
+      runs.push_back(total <= chunk_ints ? output_path : temp.create());
+      RunWriter run(runs.back(), 0, false);
+      run.write(chunk.data(), n);
+      run.close();
+      if (total <= chunk_ints) return;
+    } while (done < total);
+  }
+
+  // 2. Merge passes.
+  std::size_t fan_in = plan.fan_in, buffer_ints = plan.buffer_ints;
+  while (runs.size() > fan_in) {
+    std::vector<std::string> merged;
+    for (std::size_t i = 0; i < runs.size(); i += fan_in) {
+      std::vector<std::string> group(runs.begin() + i,
+                                     runs.begin() + std::min(runs.size(), i + fan_in));
+      if (group.size() == 1) {
+        merged.push_back(group[0]);
+        continue;
+      }
+      merged.push_back(temp.create());
+      merge_runs(group, merged.back(), buffer_ints, options.async_io);
+      for (const auto& run : group) temp.remove(run);
+    }
+    runs = std::move(merged);
+  }
+
+  merge_runs(runs, output_path, buffer_ints, options.async_io);
+}
+
+#endif // end of external_sort.h definition
@@ -0,0 +1,179 @@
+/* ====================================================================================
+   This file contains a d-ary heap and the heap sort built on it.
+
+   The heap is stored in an array with the children of node i at D*i+1 .. D*i+D, and,
+   like std::priority_queue, the top is the largest element according to Compare
+   (use std::greater for a min-heap).
+
+   - D-ary layout: a 4-ary heap is half as deep as a binary heap, and the 4 children
+     of a node are adjacent (a single cache line for ints), so a sift-down touches
+     about half as many cache lines.
+   - Bottom-up sift-down (Floyd): to remove the top, the hole left at the root is
+     moved down to a leaf by promoting the largest child at every level, without
+     comparing against the element being placed. That element (the old last leaf)
+     is then sifted up from the leaf, which usually takes one or two steps because
+     leaves are small. A binary heap needs about log2(n) comparisons per pop instead
+     of 2*log2(n).
+   - Bulk heapify: building from n elements sifts down every internal node from the
+     last one to the root, which is O(n) instead of the O(n log n) of n pushes.
+
+   Interfaces:
+     - dary_make_heap<D>(arr, n, comp), dary_push_heap<D>(arr, n, comp) and
+       dary_pop_heap<D>(arr, n, comp) work on a raw array (or any random access
+       iterator), like std::make_heap etc.
+     - DaryHeap<T, D, Compare>: a priority queue container (push, pop, top).
+     - heap_sort<D>(arr, n, comp) and heap_sort(vector<T>&): in-place heap sort,
+       O(n log n) in the worst case, used by quick_sort.h as the introsort fallback.
+=====================================================================================*/
+
+#ifndef HEAP_H
+#define HEAP_H
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+// Moves the hole at `hole` down to a leaf, then sifts `value` up from there, but
+// not above `top`. arr[0..n) must be a heap except at the hole.
+template <int D, typename It, typename Compare>
+void dary_sift_down(It arr, std::size_t n, std::size_t hole, std::size_t top,
+                    std::iter_value_t<It> value, Compare& comp) {
+  static_assert(D >= 2, "a heap needs at least 2 children per node");
+
+  // Walk down, always promoting the largest child.
+  while (true) {
+    std::size_t child = D * hole + 1;
+    if (child >= n) break;
+
+    std::size_t best = child;
+    std::size_t last = child + D < n ? child + D : n;
+    for (std::size_t c = child + 1; c < last; c++) {
+      if (comp(arr[best], arr[c])) best = c;
+    }
+    arr[hole] = std::move(arr[best]);
+    hole = best;
+  }
+
+  // Sift up from the leaf.
+  while (hole > top) {
+    std::size_t parent = (hole - 1) / D;
+    if (!comp(arr[parent], value)) break;
+    arr[hole] = std::move(arr[parent]);
+    hole = parent;
+  }
+  arr[hole] = std::move(value);
+}
+
+template <int D, typename It, typename Compare>
+void dary_sift_up(It arr, std::size_t hole, std::iter_value_t<It> value, Compare& comp) {
+  while (hole > 0) {
+    std::size_t parent = (hole - 1) / D;
+    if (!comp(arr[parent], value)) break;
+    arr[hole] = std::move(arr[parent]);
+    hole = parent;
+  }
+  arr[hole] = std::move(value);
+}
+
+/**
+ * @brief Turn arr[0..n) into a heap in O(n).
+ */
+template <int D = 4, typename It, typename Compare = std::less<std::iter_value_t<It>>>
+void dary_make_heap(It arr, std::size_t n, Compare comp = Compare()) {
+  if (n < 2) return;
+  for (std::size_t i = (n - 2) / D + 1; i-- > 0;) {
+    dary_sift_down<D>(arr, n, i, i, std::move(arr[i]), comp);
+  }
+}
+
+/**
+ * @brief Add arr[n-1] to the heap arr[0..n-1).
+ */
+template <int D = 4, typename It, typename Compare = std::less<std::iter_value_t<It>>>
+void dary_push_heap(It arr, std::size_t n, Compare comp = Compare()) {
+  if (n < 2) return;
+  dary_sift_up<D>(arr, n - 1, std::move(arr[n - 1]), comp);
+}
+
+/**
+ * @brief Move the top of the heap arr[0..n) to arr[n-1]; arr[0..n-1) stays a heap.
+ */
+template <int D = 4, typename It, typename Compare = std::less<std::iter_value_t<It>>>
+void dary_pop_heap(It arr, std::size_t n, Compare comp = Compare()) {
+  if (n < 2) return;
+  std::iter_value_t<It> value = std::move(arr[n - 1]);
+  arr[n - 1] = std::move(arr[0]);
+  dary_sift_down<D>(arr, n - 1, 0, 0, std::move(value), comp);
+}
+
+/**
+ * @brief Sort arr[0..n) in place in O(n log n).
+ */
+template <int D = 4, typename It, typename Compare = std::less<std::iter_value_t<It>>>
+  requires std::random_access_iterator<It>
+void heap_sort(It arr, std::size_t n, Compare comp = Compare()) {
+  dary_make_heap<D>(arr, n, comp);
+  for (std::size_t i = n; i > 1; i--) dary_pop_heap<D>(arr, i, comp);
+}
+
+template <typename T, typename Compare = std::less<T>>
+void heap_sort(std::vector<T>& arr, Compare comp = Compare()) {
+  heap_sort<4>(arr.data(), arr.size(), comp);
+}
+
+template <typename T, int D = 4, typename Compare = std::less<T>>
+class DaryHeap {
+  public:
+    DaryHeap() = default;
+
+    explicit DaryHeap(Compare comp) : comp(comp) {}
+
+    /**
+     * @brief Build a heap from values in O(n).
+     */
+    explicit DaryHeap(std::vector<T> values, Compare comp = Compare())
+        : data(std::move(values)), comp(comp) {
+      dary_make_heap<D>(data.data(), data.size(), this->comp);
+    }
+
+    bool empty() const { return data.empty(); }
+    std::size_t size() const { return data.size(); }
+    void reserve(std::size_t n) { data.reserve(n); }
+    void clear() { data.clear(); }
+
+    const T& top() const { return data.front(); }
+
+    void push(T value) {
+      data.push_back(std::move(value));
+      dary_push_heap<D>(data.data(), data.size(), comp);
+    }
+
+    template <typename... Args>
+    void emplace(Args&&... args) {
+      data.emplace_back(std::forward<Args>(args)...);
+      dary_push_heap<D>(data.data(), data.size(), comp);
+    }
+
+    void pop() {
+      dary_pop_heap<D>(data.data(), data.size(), comp);
+      data.pop_back();
+    }
+
+    /**
+     * @brief Remove the top and return it.
+     */
+    T extract() {
+      dary_pop_heap<D>(data.data(), data.size(), comp);
+      T top = std::move(data.back());
+      data.pop_back();
+      return top;
+    }
+
+  private:
+    std::vector<T> data;
+    Compare comp;
+};
+
+#endif // end of heap.h definition
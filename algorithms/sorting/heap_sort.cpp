@@ -0,0 +1,98 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_test_macros.hpp>
+
+#include "bits/stdc++.h"
+#include "heap.h"
+#include "test_util.h"
+using namespace std;
+
+
+template <int D>
+bool is_dary_heap(const vector<int>& arr) {
+  for (size_t i = 1; i < arr.size(); i++) {
+    if (arr[(i - 1) / D] < arr[i]) return false;
+  }
+  return true;
+}
+
+TEST_CASE("dary_make_heap function") {
+  for (int n : {0, 1, 2, 5, 100, 1001}) {
+    vector<int> arr2 = random_array(n, 0, 50, n), arr3 = arr2, arr4 = arr2, arr8 = arr2;
+    dary_make_heap<2>(arr2.data(), arr2.size());
+    dary_make_heap<3>(arr3.data(), arr3.size());
+    dary_make_heap<4>(arr4.data(), arr4.size());
+    dary_make_heap<8>(arr8.data(), arr8.size());
+    REQUIRE(is_dary_heap<2>(arr2));
+    REQUIRE(is_dary_heap<3>(arr3));
+    REQUIRE(is_dary_heap<4>(arr4));
+    REQUIRE(is_dary_heap<8>(arr8));
+  }
+}
+
+TEST_CASE("heap_sort function") {
+  vector<int> arr1 = {3, 1, 2, 5, 4};
+  heap_sort(arr1);
+  REQUIRE(arr1 == vector<int>{1, 2, 3, 4, 5});
+
+  vector<int> arr2 = {};
+  heap_sort(arr2);
+  REQUIRE(arr2.empty());
+
+  vector<int> arr3 = {-1, -3, -2, -5, -4, -3};
+  heap_sort(arr3);
+  REQUIRE(arr3 == vector<int>{-5, -4, -3, -3, -2, -1});
+
+  for (int n : {1, 10, 1000, 100000}) {
+    vector<int> arr = random_array(n, 0, n / 2, n);
+    vector<int> expected = arr;
+    std::sort(expected.begin(), expected.end());
+
+    vector<int> binary = arr;
+    heap_sort<2>(binary.data(), binary.size());
+    REQUIRE(binary == expected);
+
+    heap_sort(arr);
+    REQUIRE(arr == expected);
+  }
+}
+
+TEST_CASE("heap_sort function with a comparator") {
+  vector<string> words = {"pear", "fig", "banana", "apple", "kiwi"};
+  heap_sort(words, greater<string>());
+  REQUIRE(words == vector<string>{"pear", "kiwi", "fig", "banana", "apple"});
+}
+
+TEST_CASE("DaryHeap matches std::priority_queue") {
+  mt19937 rng(1);
+  DaryHeap<int> heap;
+  priority_queue<int> expected;
+
+  for (int step = 0; step < 20000; step++) {
+    if (expected.empty() || rng() % 3 != 0) {
+      int x = rng() % 1000;
+      heap.push(x);
+      expected.push(x);
+    }
+    else {
+      REQUIRE(heap.top() == expected.top());
+      heap.pop();
+      expected.pop();
+    }
+    REQUIRE(heap.size() == expected.size());
+  }
+}
+
+TEST_CASE("DaryHeap as a min-heap built in bulk") {
+  vector<pair<int, int>> values;
+  for (int i = 0; i < 100; i++) values.push_back({(i * 37) % 100, i});
+
+  DaryHeap<pair<int, int>, 4, greater<pair<int, int>>> heap(values);
+  for (int i = 0; i < 100; i++) {
+    REQUIRE(heap.extract().first == i);
+  }
+  REQUIRE(heap.empty());
+
+  heap.emplace(3, 0);
+  heap.emplace(1, 0);
+  REQUIRE(heap.top() == make_pair(1, 0));
+}
@@ -0,0 +1,111 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_test_macros.hpp>
+
+#include "bits/stdc++.h"
+#include "indirect_sort.h"
+#include "test_util.h"
+using namespace std;
+
+
+// A wide record sorted by a small key.
+struct Row {
+  int key;
+  int id;
+  char payload[192];
+};
+
+vector<Row> random_rows(int n, int max_key, unsigned seed) {
+  vector<int> keys = random_array(n, -max_key, max_key, seed);
+  vector<Row> rows(n);
+  for (int i = 0; i < n; i++) {
+    rows[i].key = keys[i];
+    rows[i].id = i;
+    memset(rows[i].payload, i & 0xff, sizeof(rows[i].payload));
+  }
+  return rows;
+}
+
+// The permutation argsort() should return: stable, by key.
+template <typename T, typename Comp = less<>>
+vector<size_t> expected_argsort(const vector<T>& arr, Comp comp = {}) {
+  vector<size_t> perm(arr.size());
+  iota(perm.begin(), perm.end(), size_t(0));
+  stable_sort(perm.begin(), perm.end(), [&](size_t a, size_t b) { return comp(arr[a], arr[b]); });
+  return perm;
+}
+
+TEST_CASE("argsort function") {
+  // Below and above GENERIC_RADIX_THRESHOLD, with many duplicates and without.
+  for (int n : {0, 1, 2, 100, 1023, 1024, 100000}) {
+    for (int max_value : {5, 1 << 30}) {
+      vector<int> arr = random_array(n, -max_value, max_value, n + max_value);
+      vector<int> before = arr;
+      REQUIRE(argsort(arr) == expected_argsort(arr));
+      REQUIRE(arr == before);
+    }
+  }
+
+  SECTION("other keys and orderings") {
+    vector<double> values = {2.5, -1.0, 0.0, -0.0, 1e300, -1e300, 2.5, 3.0};
+    vector<double> big;
+    for (int i = 0; i < 50; i++) big.insert(big.end(), values.begin(), values.end());
+    REQUIRE(argsort(big) == expected_argsort(big));
+
+    vector<int> arr = random_array(5000, -100, 100, 3);
+    REQUIRE(argsort(arr, greater<>()) == expected_argsort(arr, greater<>()));
+
+    vector<string> words = {"pear", "fig", "apple", "fig", "banana"};
+    REQUIRE(argsort(words.begin(), words.end()) == vector<size_t>{2, 4, 1, 3, 0});
+    REQUIRE(argsort(words, ranges::less(), &string::size) == vector<size_t>{1, 3, 0, 2, 4});
+  }
+}
+
+TEST_CASE("apply_permutation function") {
+  for (int n : {0, 1, 2, 10, 10000}) {
+    vector<int> arr = random_array(n, -1000, 1000, n);
+    vector<size_t> perm(n);
+    iota(perm.begin(), perm.end(), size_t(0));
+    shuffle(perm.begin(), perm.end(), mt19937(n));
+
+    vector<int> expected(n);
+    for (int i = 0; i < n; i++) expected[i] = arr[perm[i]];
+
+    vector<int> copy(n);
+    REQUIRE(apply_permutation_copy(arr.begin(), perm, copy.begin()) == copy.end());
+    REQUIRE(copy == expected);
+
+    apply_permutation(arr, perm);
+    REQUIRE(arr == expected);
+  }
+
+  SECTION("move-only elements in a deque") {
+    deque<unique_ptr<int>> ptrs;
+    for (int x : {3, 1, 2, 0}) ptrs.push_back(make_unique<int>(x));
+    apply_permutation(ptrs, argsort(ptrs, ranges::less(), [](const auto& p) { return *p; }));
+    for (int i = 0; i < 4; i++) REQUIRE(*ptrs[i] == i);
+  }
+}
+
+TEST_CASE("key_index_sort function") {
+  for (int n : {0, 1, 500, 50000}) {
+    for (int max_key : {10, 1 << 30}) {
+      vector<Row> rows = random_rows(n, max_key, n + max_key);
+      key_index_sort(rows, ranges::less(), &Row::key);
+
+      // Sorted by key, equal keys in input order, payloads with their rows.
+      for (int i = 1; i < n; i++) {
+        REQUIRE((rows[i - 1].key < rows[i].key ||
+                 (rows[i - 1].key == rows[i].key && rows[i - 1].id < rows[i].id)));
+      }
+      for (const Row& row : rows) REQUIRE(row.payload[191] == char(row.id & 0xff));
+    }
+  }
+
+  SECTION("descending order") {
+    vector<int> arr = random_array(3000, -50, 50, 1);
+    vector<int> expected = arr;
+    std::sort(expected.begin(), expected.end(), greater<>());
+    key_index_sort(arr.begin(), arr.end(), greater<>());
+    REQUIRE(arr == expected);
+  }
+}
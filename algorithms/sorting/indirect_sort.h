@@ -0,0 +1,166 @@
+/* ====================================================================================
+   This file contains indirect sorting: sorting a permutation of the elements instead
+   of the elements themselves, for records that are much wider than their key.
+
+   - argsort(first, last, comp, proj): the permutation that sorts the range, stably:
+     perm[i] is the index of the element that belongs at position i. The range is
+     not modified.
+       - Arithmetic keys with the default ordering, from GENERIC_RADIX_THRESHOLD
+         elements up: the (key, index) pairs are extracted into a compact array
+         (the radix key of to_radix_key() and a 32-bit index when n fits in one,
+         so 8 bytes per element for 32-bit keys) and sorted by lsd_radix_sort()
+         of radix_sort.h. Every record is read once, to extract its key.
+       - Otherwise the indices are sorted by merge_sort() (merge_sort.h), comparing
+         the projected keys of the elements they point to.
+   - apply_permutation(first, last, perm): rearranges the range in place so that
+     position i gets the element that was at perm[i]. It follows the cycles of the
+     permutation, so every element is moved once, plus one move per cycle, and
+     needs n bits to mark the positions already done.
+   - apply_permutation_copy(first, perm, out): out[i] = first[perm[i]], out of place.
+   - key_index_sort(first, last, comp, proj): argsort() then apply_permutation(),
+     i.e. a stable sort that moves every record once. For 200-byte records with a
+     4-byte key, the radix passes move 8 bytes per element instead of 200 (a 25x
+     cut per pass), and the records cross memory once instead of once per pass or
+     partition level.
+
+   @param first, last: the range to sort
+   @param comp:        the ordering of the projected keys
+   @param proj:        the key of an element, std::identity by default
+   @param perm:        a permutation of 0..n-1, as returned by argsort()
+=====================================================================================*/
+
+#ifndef INDIRECT_SORT_H
+#define INDIRECT_SORT_H
+
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "merge_sort.h"
+#include "radix_sort.h"
+#include "sort_traits.h"
+
+// A compact (key, index) pair for the radix path of argsort().
+template <typename U, typename Index>
+struct KeyIndex {
+  U key;
+  Index index;
+};
+
+// Fills perm with the stable sorting permutation of the n elements at first, by
+// radix sorting their (key, index) pairs.
+template <typename Index, typename I, typename Proj>
+void key_index_argsort(I first, std::size_t n, Proj& proj, std::vector<std::size_t>& perm) {
+  using U = decltype(to_radix_key(std::invoke(proj, *first)));
+  std::vector<KeyIndex<U, Index>> keys(n), tmp(n);
+  for (std::size_t i = 0; i < n; i++) {
+    keys[i] = {to_radix_key(std::invoke(proj, first[i])), static_cast<Index>(i)};
+  }
+
+  lsd_radix_sort(keys.data(), tmp.data(), n, [](const KeyIndex<U, Index>& e) { return e.key; });
+  for (std::size_t i = 0; i < n; i++) perm[i] = keys[i].index;
+}
+
+/**
+ * @brief Return the permutation that sorts [first, last) stably, without modifying it.
+ */
+template <typename I, typename S, typename Comp = std::ranges::less,
+          typename Proj = std::identity>
+  requires std::random_access_iterator<I> && std::sentinel_for<S, I> &&
+           std::indirect_strict_weak_order<Comp, std::projected<I, Proj>>
+std::vector<std::size_t> argsort(I first, S last, Comp comp = {}, Proj proj = {}) {
+  std::size_t n = std::ranges::next(first, last) - first;
+  std::vector<std::size_t> perm(n);
+  using Key = std::remove_cvref_t<std::indirect_result_t<Proj&, I>>;
+
+  if constexpr (is_radix_key_v<Key> && is_default_order_v<Comp, Key>) {
+    if (n >= GENERIC_RADIX_THRESHOLD) {
+      if (n <= UINT32_MAX) key_index_argsort<uint32_t>(first, n, proj, perm);
+      else key_index_argsort<std::size_t>(first, n, proj, perm);
+      return perm;
+    }
+  }
+
+  std::iota(perm.begin(), perm.end(), std::size_t(0));
+  merge_sort(perm, std::move(comp), [&](std::size_t i) -> decltype(auto) {
+    return std::invoke(proj, first[i]);
+  });
+  return perm;
+}
+
+template <typename R, typename Comp = std::ranges::less, typename Proj = std::identity>
+  requires std::ranges::random_access_range<R> &&
+           std::indirect_strict_weak_order<Comp, std::projected<std::ranges::iterator_t<R>, Proj>>
+std::vector<std::size_t> argsort(R&& range, Comp comp = {}, Proj proj = {}) {
+  return argsort(std::ranges::begin(range), std::ranges::end(range), std::move(comp),
+                 std::move(proj));
+}
+
+/**
+ * @brief Move the element at first[perm[i]] to position i, for every i, in place.
+ */
+template <typename I>
+  requires std::random_access_iterator<I> && std::permutable<I>
+void apply_permutation(I first, I last, const std::vector<std::size_t>& perm) {
+  std::size_t n = last - first;
+  std::vector<bool> done(n, false);
+
+  for (std::size_t start = 0; start < n; start++) {
+    if (done[start] || perm[start] == start) continue;
+
+    // Walk the cycle through start: every position takes the element from the
+    // position perm points to, and the last one gets the saved first element.
+    std::iter_value_t<I> saved = std::move(first[start]);
+    std::size_t i = start;
+    while (perm[i] != start) {
+      first[i] = std::move(first[perm[i]]);
+      done[i] = true;
+      i = perm[i];
+    }
+    first[i] = std::move(saved);
+    done[i] = true;
+  }
+}
+
+template <typename R>
+  requires std::ranges::random_access_range<R> && std::permutable<std::ranges::iterator_t<R>>
+void apply_permutation(R&& range, const std::vector<std::size_t>& perm) {
+  apply_permutation(std::ranges::begin(range), std::ranges::end(range), perm);
+}
+
+/**
+ * @brief Copy first[perm[i]] to out[i], for every i.
+ * @return The end of the output.
+ */
+template <typename I, typename O>
+  requires std::random_access_iterator<I> && std::indirectly_copyable<I, O>
+O apply_permutation_copy(I first, const std::vector<std::size_t>& perm, O out) {
+  for (std::size_t i : perm) *out++ = first[i];
+  return out;
+}
+
+/**
+ * @brief Sort [first, last) stably, moving every element once.
+ */
+template <typename I, typename S, typename Comp = std::ranges::less,
+          typename Proj = std::identity>
+  requires std::random_access_iterator<I> && std::sentinel_for<S, I> &&
+           std::sortable<I, Comp, Proj>
+void key_index_sort(I first, S last, Comp comp = {}, Proj proj = {}) {
+  I end = std::ranges::next(first, last);
+  apply_permutation(first, end, argsort(first, end, std::move(comp), std::move(proj)));
+}
+
+template <typename R, typename Comp = std::ranges::less, typename Proj = std::identity>
+  requires std::ranges::random_access_range<R> &&
+           std::sortable<std::ranges::iterator_t<R>, Comp, Proj>
+void key_index_sort(R&& range, Comp comp = {}, Proj proj = {}) {
+  key_index_sort(std::ranges::begin(range), std::ranges::end(range), std::move(comp),
+                 std::move(proj));
+}
+
+#endif // end of indirect_sort.h definition
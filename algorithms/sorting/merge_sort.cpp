@@ -0,0 +1,128 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_test_macros.hpp>
+
+#include "bits/stdc++.h"
+#include "merge_sort.h"
+#include "test_util.h"
+using namespace std;
+
+
+// Counts its calls.
+struct CountingLess {
+  long long* calls;
+  bool operator()(int a, int b) const {
+    (*calls)++;
+    return a < b;
+  }
+};
+
+long long count_comparisons(vector<int> arr) {
+  long long calls = 0;
+  merge_sort(arr, CountingLess{&calls});
+  REQUIRE(is_sorted(arr.begin(), arr.end()));
+  return calls;
+}
+
+TEST_CASE("node_power function") {
+  // Boundaries at n / 2, n / 4 and 3n / 4, n / 8 are the depths 1, 2, 2 and 3.
+  REQUIRE(node_power(16, 0, 8, 16) == 1);
+  REQUIRE(node_power(16, 0, 4, 8) == 2);
+  REQUIRE(node_power(16, 8, 12, 16) == 2);
+  REQUIRE(node_power(16, 0, 2, 4) == 3);
+  REQUIRE(node_power(16, 4, 6, 8) == 3);
+}
+
+TEST_CASE("merge_sort function against std::stable_sort") {
+  for (int n : {0, 1, 2, 23, 24, 25, 100, 1000, 100000}) {
+    for (int max_value : {3, 1000, 1 << 30}) {
+      vector<int> arr = random_array(n, -max_value, max_value, n + max_value);
+      vector<int> expected = arr;
+      std::sort(expected.begin(), expected.end());
+      merge_sort(arr);
+      REQUIRE(arr == expected);
+    }
+  }
+
+  SECTION("descending order and other containers") {
+    vector<int> arr = random_array(5000, -100, 100, 7);
+    deque<int> dq(arr.begin(), arr.end());
+    merge_sort(dq, greater<>());
+    std::sort(arr.begin(), arr.end(), greater<>());
+    REQUIRE(equal(dq.begin(), dq.end(), arr.begin()));
+
+    vector<string> words = {"pear", "fig", "apple", "kiwi", "banana", "fig"};
+    merge_sort(words.begin(), words.end());
+    REQUIRE(words == vector<string>{"apple", "banana", "fig", "fig", "kiwi", "pear"});
+  }
+}
+
+TEST_CASE("merge_sort function is stable") {
+  // Few distinct keys, in random order, in natural runs and in descending runs,
+  // which are reversed: equal keys must keep their original order in all of them.
+  mt19937 rng(3);
+  for (int pattern = 0; pattern < 3; pattern++) {
+    vector<pair<int, int>> records(20000);
+    for (int i = 0; i < 20000; i++) {
+      int key = rng() % 16;
+      if (pattern == 1) key = (i / 500) % 16 + (i % 500) / 100;
+      if (pattern == 2) key = 16 - (i % 700) / 50;
+      records[i] = {key, i};
+    }
+
+    vector<pair<int, int>> expected = records;
+    stable_sort(expected.begin(), expected.end(),
+                [](const auto& a, const auto& b) { return a.first < b.first; });
+    merge_sort(records, ranges::less(), &pair<int, int>::first);
+    REQUIRE(records == expected);
+  }
+}
+
+TEST_CASE("merge_sort function on partially ordered input") {
+  int n = 100000;
+  vector<int> sorted = sorted_array(n);
+
+  SECTION("sorted and reversed input take n - 1 comparisons") {
+    REQUIRE(count_comparisons(sorted) == n - 1);
+    REQUIRE(count_comparisons(vector<int>(sorted.rbegin(), sorted.rend())) == n - 1);
+    REQUIRE(count_comparisons(vector<int>(n, 5)) == n - 1);
+  }
+
+  SECTION("a few misplaced elements") {
+    vector<int> arr = sorted;
+    mt19937 rng(11);
+    for (int i = 0; i < 10; i++) swap(arr[rng() % n], arr[rng() % n]);
+    REQUIRE(count_comparisons(arr) < 2 * n);
+  }
+
+  SECTION("sorted blocks and an appended tail") {
+    // Sorted blocks of 10000 in random order. Finding the runs takes n - 1
+    // comparisons, and galloping merges them in a few hundred more, against about
+    // n log2(10) for merging element by element.
+    vector<int> arr = sorted;
+    vector<int> blocks(10);
+    iota(blocks.begin(), blocks.end(), 0);
+    shuffle(blocks.begin(), blocks.end(), mt19937(5));
+    for (int b = 0; b < 10; b++) {
+      for (int i = 0; i < 10000; i++) arr[b * 10000 + i] = blocks[b] * 10000 + i;
+    }
+    REQUIRE(count_comparisons(arr) < n + 1000);
+
+    // A sorted array with random elements appended, as after a batch of inserts.
+    vector<int> appended = sorted;
+    vector<int> tail = random_array(1000, -n, n, 9);
+    appended.insert(appended.end(), tail.begin(), tail.end());
+    REQUIRE(count_comparisons(appended) < 2 * n);
+  }
+
+  SECTION("interleaved runs") {
+    // Two ascending runs that alternate element by element, so galloping never
+    // pays off: the failed attempts must cost next to nothing over the n - 1
+    // comparisons of finding the runs and the n - 1 of merging them.
+    vector<int> arr(n);
+    for (int i = 0; i < n / 2; i++) {
+      arr[i] = 2 * i;
+      arr[n / 2 + i] = 2 * i + 1;
+    }
+    REQUIRE(count_comparisons(arr) < 2 * n + 100);
+  }
+}
@@ -0,0 +1,320 @@
+/* ====================================================================================
+   This file contains merge_sort(): a stable, adaptive natural merge sort (powersort,
+   with TimSort's merging), for input that is already partly in order.
+
+   - Runs: the input is scanned for natural runs, ascending or strictly descending
+     (reversed in place; strictly, so equal keys keep their order). Runs shorter
+     than MERGE_SORT_MIN_RUN are extended to that length with binary insertion
+     sort.
+   - Merge policy (powersort, Munro and Wild): every boundary between two adjacent
+     runs gets a power, the depth of the boundary's midpoint in a perfectly balanced
+     merge tree over [0, n). Runs wait on a stack, and a new boundary first merges
+     every run on the stack whose boundary is deeper than it. The merge tree is
+     then within a few percent of optimal for the run lengths: n * H(run lengths)
+     comparisons, so k runs cost O(n log k) and a sorted input O(n).
+   - Merging (TimSort): the part of the left run that is <= the first element of
+     the right run, and the part of the right run >= the last element of the left
+     run, are already in place and are skipped with exponential searches. The
+     smaller of the remaining runs is moved to the buffer and merged from its end
+     of the range. When one run wins MIN_GALLOP comparisons in a row, the merge
+     switches to galloping: it finds with an exponential search how many elements
+     of that run go next and moves them as a block, so merging runs that barely
+     interleave costs O(log) per block rather than one comparison per element.
+     min_gallop adapts: it drops while galloping pays off and rises when it stops.
+   - Memory: one buffer of n / 2 elements, allocated on the first merge, and a
+     fixed-size run stack (powers are at most 64).
+
+   Nearly sorted input (long runs with a little disorder) sorts in close to O(n)
+   comparisons; random input costs about n log2(n), like any merge sort.
+
+   @param first, last: the range to sort
+   @param comp:        the ordering of the projected keys
+   @param proj:        the key of an element, std::identity by default
+=====================================================================================*/
+
+#ifndef MERGE_SORT_H
+#define MERGE_SORT_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+#include "sort_traits.h"
+
+const std::ptrdiff_t MERGE_SORT_MIN_RUN = 24;
+const int MIN_GALLOP = 7;
+
+// Returns the first position p in [first, last) where pred(*p) is false, given
+// that pred is true on a prefix. Exponential search from first, so the cost is
+// O(log(p - first)).
+template <typename I, typename Pred>
+I gallop_forward(I first, I last, Pred pred) {
+  std::ptrdiff_t n = last - first, prev = 0, ofs = 1;
+  while (ofs <= n && pred(first[ofs - 1])) {
+    prev = ofs;
+    ofs = 2 * ofs;
+  }
+  return std::partition_point(first + prev, first + std::min(ofs, n), pred);
+}
+
+// Returns the first position p in [first, last) where pred is true on [p, last),
+// given that pred is true on a suffix. Exponential search from last.
+template <typename I, typename Pred>
+I gallop_backward(I first, I last, Pred pred) {
+  std::ptrdiff_t n = last - first, prev = 0, ofs = 1;
+  while (ofs <= n && pred(last[-ofs])) {
+    prev = ofs;
+    ofs = 2 * ofs;
+  }
+  return std::partition_point(last - std::min(ofs, n), last - prev,
+                              [&](const auto& x) { return !pred(x); });
+}
+
+// Sorts [first, last), where [first, sorted_end) is already sorted, by binary
+// insertion. Equal elements are inserted after each other, so it is stable.
+template <typename I, typename Less>
+void binary_insertion_sort(I first, I sorted_end, I last, Less& less) {
+  for (I i = sorted_end; i != last; ++i) {
+    std::iter_value_t<I> x = std::move(*i);
+    I pos = std::upper_bound(first, i, x, less);
+    std::move_backward(pos, i, i + 1);
+    *pos = std::move(x);
+  }
+}
+
+// Returns the end of the natural run starting at first, reversing it if it is
+// strictly descending.
+template <typename I, typename Less>
+I count_run(I first, I last, Less& less) {
+  I run_end = first + 1;
+  if (run_end == last) return run_end;
+
+  if (less(*run_end, *first)) {
+    while (++run_end != last && less(*run_end, *(run_end - 1))) {}
+    std::reverse(first, run_end);
+  }
+  else {
+    while (++run_end != last && !less(*run_end, *(run_end - 1))) {}
+  }
+  return run_end;
+}
+
+// The depth, in a balanced merge tree over [0, n), of the boundary between the runs
+// [a, b) and [b, c): the number of leading binary digits that the midpoints of
+// the two runs, as fractions of n, have in common, plus one.
+inline int node_power(std::size_t n, std::size_t a, std::size_t b, std::size_t c) {
+  std::size_t l = a + b, r = b + c;  // twice the midpoints
+  int power = 0;
+  while (true) {
+    power++;
+    bool digit_l = l >= n, digit_r = r >= n;
+    if (digit_l != digit_r) return power;
+    if (digit_l) {
+      l -= n;
+      r -= n;
+    }
+    l *= 2;
+    r *= 2;
+  }
+}
+
+template <typename I, typename Less>
+class RunMerger {
+  public:
+    RunMerger(std::size_t n, Less& less) : n(n), less(less) {}
+
+    /**
+     * @brief Merge the sorted runs [first, mid) and [mid, last), stably.
+     */
+    void merge(I first, I mid, I last) {
+      // Skip the prefix of the left run and the suffix of the right run that are
+      // already in place.
+      first = gallop_forward(first, mid, [&](const auto& x) { return !less(*mid, x); });
+      if (first == mid) return;
+      last = gallop_backward(mid, last, [&](const auto& y) { return !less(y, *(mid - 1)); });
+      if (mid == last) return;
+
+      if (buf.capacity() == 0) buf.reserve(n / 2 + 1);
+      if (mid - first <= last - mid) merge_lo(first, mid, last);
+      else merge_hi(first, mid, last);
+    }
+
+  private:
+    std::size_t n;
+    Less& less;
+    std::vector<std::iter_value_t<I>> buf;
+    int min_gallop = MIN_GALLOP;
+
+    // Moves the left run to the buffer and merges from the front. The first
+    // element of the right run is known to go first.
+    void merge_lo(I first, I mid, I last) {
+      buf.assign(std::make_move_iterator(first), std::make_move_iterator(mid));
+      auto b = buf.begin(), b_end = buf.end();
+      I r = mid, out = first;
+
+      *out++ = std::move(*r++);
+      while (b != b_end && r != last) {
+        // One element at a time, until one run wins min_gallop times in a row.
+        int count_l = 0, count_r = 0;
+        do {
+          if (less(*r, *b)) {
+            *out++ = std::move(*r++);
+            count_r++;
+            count_l = 0;
+            if (r == last) goto done;
+          }
+          else {
+            *out++ = std::move(*b++);
+            count_l++;
+            count_r = 0;
+            if (b == b_end) goto done;
+          }
+        } while ((count_l | count_r) < min_gallop);
+
+        // Galloping: move blocks while they stay long.
+        do {
+          auto nb = gallop_forward(b, b_end, [&](const auto& x) { return !less(*r, x); });
+          count_l = nb - b;
+          out = std::move(b, nb, out);
+          b = nb;
+          if (b == b_end) goto done;
+          *out++ = std::move(*r++);
+          if (r == last) goto done;
+
+          I nr = gallop_forward(r, last, [&](const auto& y) { return less(y, *b); });
+          count_r = nr - r;
+          out = std::move(r, nr, out);
+          r = nr;
+          if (r == last) goto done;
+          *out++ = std::move(*b++);
+          if (b == b_end) goto done;
+
+          min_gallop--;
+        } while (count_l >= MIN_GALLOP || count_r >= MIN_GALLOP);
+        min_gallop = std::max(min_gallop, 0) + 2;
+      }
+
+    done:
+      std::move(b, b_end, out);
+    }
+
+    // Moves the right run to the buffer and merges from the back. The last element
+    // of the left run is known to go last.
+    void merge_hi(I first, I mid, I last) {
+      buf.assign(std::make_move_iterator(mid), std::make_move_iterator(last));
+      auto b_begin = buf.begin(), b = buf.end();
+      I l = mid, out = last;
+
+      *--out = std::move(*--l);
+      while (b != b_begin && l != first) {
+        int count_l = 0, count_r = 0;
+        do {
+          if (less(*(b - 1), *(l - 1))) {
+            *--out = std::move(*--l);
+            count_l++;
+            count_r = 0;
+            if (l == first) goto done;
+          }
+          else {
+            *--out = std::move(*--b);
+            count_r++;
+            count_l = 0;
+            if (b == b_begin) goto done;
+          }
+        } while ((count_l | count_r) < min_gallop);
+
+        do {
+          I nl = gallop_backward(first, l, [&](const auto& x) { return less(*(b - 1), x); });
+          count_l = l - nl;
+          out = std::move_backward(nl, l, out);
+          l = nl;
+          if (l == first) goto done;
+          *--out = std::move(*--b);
+          if (b == b_begin) goto done;
+
+          auto nb = gallop_backward(b_begin, b, [&](const auto& y) { return !less(y, *(l - 1)); });
+          count_r = b - nb;
+          out = std::move_backward(nb, b, out);
+          b = nb;
+          if (b == b_begin) goto done;
+          *--out = std::move(*--l);
+          if (l == first) goto done;
+
+          min_gallop--;
+        } while (count_l >= MIN_GALLOP || count_r >= MIN_GALLOP);
+        min_gallop = std::max(min_gallop, 0) + 2;
+      }
+
+    done:
+      std::move_backward(b_begin, b, out);
+    }
+};
+
+/**
+ * @brief Sort [first, last) stably, in close to O(n) if it is nearly sorted.
+ */
+template <typename I, typename S, typename Comp = std::ranges::less,
+          typename Proj = std::identity>
+  requires std::random_access_iterator<I> && std::sentinel_for<S, I> &&
+           std::sortable<I, Comp, Proj>
+void merge_sort(I first, S last, Comp comp = {}, Proj proj = {}) {
+  I end = std::ranges::next(first, last);
+  std::size_t n = end - first;
+  if (n < 2) return;
+  auto less = projected_less(comp, proj);
+
+  // Runs waiting to be merged, with the power of the boundary to their right.
+  struct Run {
+    I begin, end;
+    int power;
+  };
+  std::array<Run, 65> stack;
+  int top = 0;
+  RunMerger<I, decltype(less)> merger(n, less);
+
+  auto next_run = [&](I begin) {
+    I run_end = count_run(begin, end, less);
+    if (run_end - begin < MERGE_SORT_MIN_RUN) {
+      I extended = begin + std::min<std::ptrdiff_t>(MERGE_SORT_MIN_RUN, end - begin);
+      binary_insertion_sort(begin, run_end, extended, less);
+      run_end = extended;
+    }
+    return run_end;
+  };
+
+  I a_begin = first, a_end = next_run(first);
+  while (a_end != end) {
+    I b_end = next_run(a_end);
+    int power = node_power(n, a_begin - first, a_end - first, b_end - first);
+
+    // Merge the runs whose boundary is deeper than the new one.
+    while (top > 0 && stack[top - 1].power > power) {
+      top--;
+      merger.merge(stack[top].begin, a_begin, a_end);
+      a_begin = stack[top].begin;
+    }
+    stack[top++] = {a_begin, a_end, power};
+    a_begin = a_end;
+    a_end = b_end;
+  }
+
+  while (top > 0) {
+    top--;
+    merger.merge(stack[top].begin, a_begin, a_end);
+    a_begin = stack[top].begin;
+  }
+}
+
+template <typename R, typename Comp = std::ranges::less, typename Proj = std::identity>
+  requires std::ranges::random_access_range<R> &&
+           std::sortable<std::ranges::iterator_t<R>, Comp, Proj>
+void merge_sort(R&& range, Comp comp = {}, Proj proj = {}) {
+  merge_sort(std::ranges::begin(range), std::ranges::end(range), std::move(comp), std::move(proj));
+}
+
+#endif // end of merge_sort.h definition
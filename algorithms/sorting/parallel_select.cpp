@@ -0,0 +1,82 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_test_macros.hpp>
+
+#include "bits/stdc++.h"
+#include "parallel_select.h"
+#include "test_util.h"
+using namespace std;
+
+
+vector<vector<int>> test_inputs(int n) {
+  return {random_array(n, INT_MIN, INT_MAX, n), sorted_array(n), reversed_array(n),
+          random_array(n, INT_MIN, INT_MIN + 3, n), vector<int>(n, 5)};
+}
+
+TEST_CASE("top_k_filter function") {
+  vector<int> arr = {5, 1, 9, 3, 9, 7, 2, 8};
+  vector<int> top = top_k_filter(arr.data(), arr.size(), 3);
+  std::sort(top.begin(), top.end());
+  REQUIRE(top == vector<int>{8, 9, 9});
+
+  REQUIRE(top_k_filter(arr.data(), arr.size(), 0).empty());
+  REQUIRE(top_k_filter(arr.data(), 2, 5).size() == 2);
+
+  vector<int> extremes = {INT_MIN, INT_MIN, INT_MAX, INT_MIN};
+  top = top_k_filter(extremes.data(), extremes.size(), 2);
+  std::sort(top.begin(), top.end());
+  REQUIRE(top == vector<int>{INT_MIN, INT_MAX});
+}
+
+TEST_CASE("parallel_select function") {
+  WorkStealingPool pool(4);
+
+  REQUIRE(parallel_select(vector<int>{3, 1, 2}, 0, pool) == 1);
+  REQUIRE_THROWS_AS(parallel_select(vector<int>{}, 0, pool), out_of_range);
+  REQUIRE_THROWS_AS(parallel_select(vector<int>{3, 1, 2}, 3, pool), out_of_range);
+  REQUIRE_THROWS_AS(parallel_select(random_array(300001, INT_MIN, 100, 8), 300001, pool), out_of_range);
+
+  for (int n : {1000, 300001}) {
+    for (const vector<int>& arr : test_inputs(n)) {
+      vector<int> expected = arr;
+      std::sort(expected.begin(), expected.end());
+
+      for (size_t k : {size_t(0), size_t(1), size_t(n / 2), size_t(n * 99 / 100), size_t(n - 1)}) {
+        vector<int> input = arr;
+        REQUIRE(parallel_select(input, k, pool) == expected[k]);
+        REQUIRE(input == arr);
+      }
+    }
+  }
+
+  vector<int> arr = random_array(200000, INT_MIN, 100, 7);
+  vector<int> expected = arr;
+  std::sort(expected.begin(), expected.end());
+  REQUIRE(parallel_select(arr, 12345, 1) == expected[12345]);
+}
+
+TEST_CASE("parallel_top_k function") {
+  WorkStealingPool pool(4);
+
+  REQUIRE(parallel_top_k(vector<int>{}, 3, pool).empty());
+  REQUIRE(parallel_top_k(vector<int>{4, 8, 1}, 5, pool) == vector<int>{8, 4, 1});
+  REQUIRE(parallel_top_k(vector<int>{4, 8, 1}, 0, pool).empty());
+
+  for (int n : {1000, 300001}) {
+    for (const vector<int>& arr : test_inputs(n)) {
+      vector<int> expected = arr;
+      std::sort(expected.begin(), expected.end(), greater<int>());
+
+      for (size_t k : {size_t(1), size_t(1000), size_t(TOP_K_FILTER_LIMIT + 1), size_t(n / 2)}) {
+        k = min<size_t>(k, n);
+        vector<int> input = arr;
+        vector<int> top = parallel_top_k(input, k, pool);
+        REQUIRE(top == vector<int>(expected.begin(), expected.begin() + k));
+        REQUIRE(input == arr);
+
+        vector<int> unsorted = parallel_top_k(input, k, pool, false);
+        std::sort(unsorted.begin(), unsorted.end(), greater<int>());
+        REQUIRE(unsorted == top);
+      }
+    }
+  }
+}
@@ -0,0 +1,248 @@
+/* ====================================================================================
+   This file contains parallel selection and top-k for vector<int>. Neither function
+   reorders its input, and both run their passes over the array on a
+   WorkStealingPool (see work_stealing_pool.h).
+
+   parallel_select(arr, k): the element that would be at index k if arr were sorted.
+   k >= arr.size() throws std::out_of_range, like multi_select().
+     1. Draw a random sample of s = min(n^(2/3), SELECT_MAX_SAMPLE) elements and pick
+        two of them, lo and hi, whose ranks in the sample are SELECT_SAMPLE_SIGMAS *
+        sqrt(s) below and above k * s / n. The k-th element is almost certainly
+        between them, and only about 2 * SELECT_SAMPLE_SIGMAS * n / sqrt(s) elements
+        are (2.5M of 500M).
+     2. In parallel, every block counts its elements < lo, == lo, strictly between
+        lo and hi, and == hi. The counts tell whether the answer is lo, hi or one of
+        the elements in between.
+     3. In the last case the blocks copy their in-between elements to a candidate
+        array (at offsets given by prefix sums of the counts), and
+        floyd_rivest_select() (quick_select.h) finds the answer among them.
+     If the sample was unlucky and the k-th element is outside [lo, hi], it sorts a
+     copy with parallel_sort(). That takes a deviation of SELECT_SAMPLE_SIGMAS
+     standard deviations, so it practically never happens.
+
+   parallel_top_k(arr, k, sorted): the k largest elements, in descending order if
+   sorted is true.
+     - k <= TOP_K_FILTER_LIMIT: every block keeps the candidates above a threshold in
+       a buffer of 2k elements (top_k_filter(), a StreamingTopK from
+       streaming_select.h). When the buffer is full, the k largest survive and the
+       smallest of them becomes the new threshold, so after the first few thousand
+       elements almost everything is rejected by a vector compare. The blocks'
+       results are reduced the same way. One pass over arr.
+     - Larger k: t = parallel_select(arr, n - k), then the blocks copy out their
+       elements > t, and copies of t fill up the remaining slots.
+
+   @param arr:       the array to select from
+   @param k:         the rank to select / the number of elements to return
+   @param n_threads: the number of threads, hardware_concurrency() if <= 0
+=====================================================================================*/
+
+#ifndef PARALLEL_SELECT_H
+#define PARALLEL_SELECT_H
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "parallel_sort.h"
+#include "quick_select.h"
+#include "streaming_select.h"
+
+const std::size_t PARALLEL_SELECT_GRAIN = 1 << 16;
+const std::size_t SELECT_MAX_SAMPLE = 1 << 20;
+const int SELECT_SAMPLE_SIGMAS = 2;
+const std::size_t TOP_K_FILTER_LIMIT = 1 << 14;
+
+// Splits [0, n) into n_blocks ranges and runs f(block, begin, end) on each in parallel.
+template <typename F>
+void parallel_for_blocks(WorkStealingPool& pool, std::size_t n, std::size_t n_blocks, F f) {
+  std::size_t block = (n + n_blocks - 1) / n_blocks;
+  TaskGroup group;
+  for (std::size_t b = 0; b < n_blocks; b++) {
+    pool.spawn(group, [=, &f] { f(b, b * block, std::min(n, (b + 1) * block)); });
+  }
+  pool.wait(group);
+}
+
+// A few blocks per thread balance the load, but no block is smaller than
+// PARALLEL_SORT_BLOCK elements.
+inline std::size_t select_block_count(std::size_t n, WorkStealingPool& pool) {
+  return std::max<std::size_t>(1, std::min<std::size_t>(4 * pool.size(), n / PARALLEL_SORT_BLOCK));
+}
+
+/**
+ * @brief Return the min(k, n) largest elements of arr[0..n), in no particular order.
+ */
+inline std::vector<int> top_k_filter(const int* arr, std::size_t n, std::size_t k) {
+  StreamingTopK top(k);
+  top.push(arr, n);
+  return top.top(false);
+}
+
+/**
+ * @brief Find the element that would be at index k if arr were sorted, without
+ *        modifying arr.
+ * @throws std::out_of_range if k >= arr.size().
+ */
+inline int parallel_select(const std::vector<int>& arr, std::size_t k, WorkStealingPool& pool) {
+  std::size_t n = arr.size();
+  const int* data = arr.data();
+  if (k >= n) throw std::out_of_range("parallel_select: k out of range");
+  if (n <= PARALLEL_SELECT_GRAIN) {
+    std::vector<int> copy = arr;
+    floyd_rivest_select(copy.data(), 0, n - 1, k);
+    return copy[k];
+  }
+
+  // 1. Bracket the k-th element between two sample elements.
+  std::size_t n_blocks = select_block_count(n, pool);
+  std::size_t s = std::min<std::size_t>(SELECT_MAX_SAMPLE, std::cbrt(static_cast<double>(n) * n));
+  std::vector<int> sample(s);
+  parallel_for_blocks(pool, s, n_blocks, [&](std::size_t b, std::size_t begin, std::size_t end) {
+    uint64_t seed = n ^ (b * 0x9e3779b97f4a7c15ULL);
+    for (std::size_t i = begin; i < end; i++) sample[i] = data[splitmix64(seed) % n];
+  });
+
+  double rank = static_cast<double>(k) * s / n;
+  double delta = SELECT_SAMPLE_SIGMAS * std::sqrt(static_cast<double>(s));
+  long long lo_rank = static_cast<long long>(rank - delta);
+  long long hi_rank = static_cast<long long>(rank + delta) + 1;
+
+  int lo = INT_MIN, hi = INT_MAX;
+  if (hi_rank < static_cast<long long>(s)) {
+    floyd_rivest_select(sample.data(), 0, s - 1, hi_rank);
+    hi = sample[hi_rank];
+  }
+  if (lo_rank >= 0) {
+    long long last = std::min<long long>(hi_rank, s) - 1;
+    floyd_rivest_select(sample.data(), 0, last, lo_rank);
+    lo = sample[lo_rank];
+  }
+
+  // 2. Count, per block, the elements in each part of the window.
+  struct WindowCounts {
+    std::size_t less = 0, equal_lo = 0, between = 0, equal_hi = 0;
+  };
+  std::vector<WindowCounts> counts(n_blocks);
+  parallel_for_blocks(pool, n, n_blocks, [&](std::size_t b, std::size_t begin, std::size_t end) {
+    WindowCounts c;
+    for (std::size_t i = begin; i < end; i++) {
+      int x = data[i];
+      c.less += x < lo;
+      c.equal_lo += x == lo;
+      c.between += (x > lo) & (x < hi);
+      c.equal_hi += x == hi;
+    }
+    counts[b] = c;
+  });
+
+  WindowCounts total;
+  for (const WindowCounts& c : counts) {
+    total.less += c.less;
+    total.equal_lo += c.equal_lo;
+    total.between += c.between;
+    total.equal_hi += c.equal_hi;
+  }
+
+  std::size_t below = total.less;
+  if (k >= below) {
+    if (k < below + total.equal_lo) return lo;
+    below += total.equal_lo;
+
+    // 3. Gather the elements strictly between lo and hi and select among them.
+    if (k < below + total.between) {
+      std::vector<std::size_t> offsets(n_blocks + 1, 0);
+      for (std::size_t b = 0; b < n_blocks; b++) offsets[b + 1] = offsets[b] + counts[b].between;
+
+      // lo < x < hi as one unsigned comparison, so the branch is almost never taken
+      // and always predicted (x > lo && x < hi would be a coin flip on random keys).
+      uint32_t width = static_cast<uint32_t>(hi) - static_cast<uint32_t>(lo) - 1;
+      std::vector<int> candidates(total.between);
+      parallel_for_blocks(pool, n, n_blocks, [&](std::size_t b, std::size_t begin, std::size_t end) {
+        int* out = candidates.data() + offsets[b];
+        for (std::size_t i = begin; i < end; i++) {
+          if (static_cast<uint32_t>(data[i]) - static_cast<uint32_t>(lo) - 1 < width) *out++ = data[i];
+        }
+      });
+
+      floyd_rivest_select(candidates.data(), 0, candidates.size() - 1, k - below);
+      return candidates[k - below];
+    }
+    below += total.between;
+
+    if (lo != hi && k < below + total.equal_hi) return hi;
+  }
+
+  // The sample missed the k-th element.
+  std::vector<int> copy = arr;
+  parallel_sort(copy, pool);
+  return copy[k];
+}
+
+inline int parallel_select(const std::vector<int>& arr, std::size_t k, int n_threads = 0) {
+  WorkStealingPool pool(n_threads);
+  return parallel_select(arr, k, pool);
+}
+
+/**
+ * @brief Return the k largest elements of arr, without modifying arr.
+ * @param sorted Return them in descending order.
+ */
+inline std::vector<int> parallel_top_k(const std::vector<int>& arr, std::size_t k,
+                                       WorkStealingPool& pool, bool sorted = true) {
+  std::size_t n = arr.size();
+  const int* data = arr.data();
+  std::vector<int> result;
+
+  if (k >= n) {
+    result = arr;
+  }
+  else if (k <= TOP_K_FILTER_LIMIT) {
+    std::size_t n_blocks = select_block_count(n, pool);
+    std::vector<std::vector<int>> block_top(n_blocks);
+    parallel_for_blocks(pool, n, n_blocks, [&](std::size_t b, std::size_t begin, std::size_t end) {
+      block_top[b] = top_k_filter(data + begin, end - begin, k);
+    });
+
+    std::vector<int> merged;
+    for (const auto& top : block_top) merged.insert(merged.end(), top.begin(), top.end());
+    result = top_k_filter(merged.data(), merged.size(), k);
+  }
+  else {
+    int t = parallel_select(arr, n - k, pool);
+
+    std::size_t n_blocks = select_block_count(n, pool);
+    std::vector<std::size_t> offsets(n_blocks + 1, 0);
+    parallel_for_blocks(pool, n, n_blocks, [&](std::size_t b, std::size_t begin, std::size_t end) {
+      std::size_t c = 0;
+      for (std::size_t i = begin; i < end; i++) c += data[i] > t;
+      offsets[b + 1] = c;
+    });
+    for (std::size_t b = 0; b < n_blocks; b++) offsets[b + 1] += offsets[b];
+
+    // The slots after the elements > t keep copies of t.
+    result.assign(k, t);
+    parallel_for_blocks(pool, n, n_blocks, [&](std::size_t b, std::size_t begin, std::size_t end) {
+      int* out = result.data() + offsets[b];
+      for (std::size_t i = begin; i < end; i++) {
+        if (data[i] > t) *out++ = data[i];
+      }
+    });
+  }
+
+  if (sorted) {
+    parallel_sort(result, pool);
+    std::reverse(result.begin(), result.end());
+  }
+  return result;
+}
+
+inline std::vector<int> parallel_top_k(const std::vector<int>& arr, std::size_t k,
+                                       bool sorted = true, int n_threads = 0) {
+  WorkStealingPool pool(n_threads);
+  return parallel_top_k(arr, k, pool, sorted);
+}
+
+#endif // end of parallel_select.h definition
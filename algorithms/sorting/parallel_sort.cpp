@@ -0,0 +1,116 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_test_macros.hpp>
+
+#include "bits/stdc++.h"
+#include "parallel_sort.h"
+#include "test_util.h"
+using namespace std;
+
+
+void require_sorted_like_std(vector<int> arr, int n_threads) {
+  vector<int> expected = arr;
+  std::sort(expected.begin(), expected.end());
+  parallel_sort(arr, n_threads);
+  REQUIRE(arr == expected);
+}
+
+TEST_CASE("WorkStealingPool runs nested tasks") {
+  WorkStealingPool pool(4);
+  atomic<int> count{0};
+
+  function<void(int)> spawn_tree = [&](int depth) {
+    count++;
+    if (depth == 0) return;
+    TaskGroup group;
+    for (int i = 0; i < 3; i++) pool.spawn(group, [&, depth] { spawn_tree(depth - 1); });
+    pool.wait(group);
+  };
+  spawn_tree(6);
+
+  // 1 + 3 + 9 + ... + 3^6
+  REQUIRE(count == 1093);
+}
+
+TEST_CASE("WorkStealingPool rethrows exceptions of tasks") {
+  WorkStealingPool pool(4);
+  atomic<int> count{0};
+
+  // Every other task runs, and wait() throws only once they have all finished.
+  TaskGroup group;
+  for (int i = 0; i < 200; i++) {
+    pool.spawn(group, [&, i] {
+      if (i % 50 == 7) throw runtime_error("task failed");
+      this_thread::sleep_for(chrono::microseconds(50));
+      count++;
+    });
+  }
+  REQUIRE_THROWS_AS(pool.wait(group), runtime_error);
+  REQUIRE(count == 196);
+  REQUIRE(group.pending == 0);
+
+  // An exception from a nested group reaches the outer one, and the pool still works.
+  TaskGroup outer;
+  pool.spawn(outer, [&] {
+    TaskGroup inner;
+    pool.spawn(inner, [] { throw out_of_range("nested"); });
+    pool.wait(inner);
+  });
+  REQUIRE_THROWS_AS(pool.wait(outer), out_of_range);
+
+  TaskGroup after;
+  pool.spawn(after, [&] { count++; });
+  pool.wait(after);
+  REQUIRE(count == 197);
+}
+
+TEST_CASE("sample_bucket_of function") {
+  vector<int> splitters = {-5, 0, 7, INT_MAX};
+  REQUIRE(sample_bucket_of(splitters.data(), 3, INT_MIN) == 0);
+  REQUIRE(sample_bucket_of(splitters.data(), 3, -5) == 1);
+  REQUIRE(sample_bucket_of(splitters.data(), 3, -1) == 2);
+  REQUIRE(sample_bucket_of(splitters.data(), 3, 0) == 3);
+  REQUIRE(sample_bucket_of(splitters.data(), 3, 5) == 4);
+  REQUIRE(sample_bucket_of(splitters.data(), 3, 7) == 5);
+  REQUIRE(sample_bucket_of(splitters.data(), 3, 8) == 6);
+  REQUIRE(sample_bucket_of(splitters.data(), 3, INT_MAX) == 7);
+}
+
+TEST_CASE("parallel_sort function with small inputs") {
+  for (int n : {0, 1, 2, 100, 1000}) {
+    require_sorted_like_std(random_array(n, INT_MIN, INT_MAX, n), 4);
+  }
+}
+
+TEST_CASE("parallel_sort function with large random inputs") {
+  for (int n_threads : {1, 2, 4, 8}) {
+    require_sorted_like_std(random_array(1 << 20, INT_MIN, INT_MAX, n_threads), n_threads);
+    require_sorted_like_std(random_array(300000, INT_MIN, INT_MIN + 100, n_threads), n_threads);
+  }
+}
+
+TEST_CASE("parallel_sort function with adversarial patterns") {
+  const int n = 1 << 20;
+
+  vector<int> ascending = sorted_array(n), descending = reversed_array(n), equal(n, 7),
+              organ_pipe = organ_pipe_array(n), extremes(n);
+  for (int i = 0; i < n; i++) extremes[i] = i % 3 == 0 ? INT_MAX : (i % 3 == 1 ? INT_MIN : 0);
+
+  for (int n_threads : {2, 4}) {
+    require_sorted_like_std(ascending, n_threads);
+    require_sorted_like_std(descending, n_threads);
+    require_sorted_like_std(equal, n_threads);
+    require_sorted_like_std(organ_pipe, n_threads);
+    require_sorted_like_std(extremes, n_threads);
+  }
+}
+
+TEST_CASE("parallel_sort function with a shared pool") {
+  WorkStealingPool pool(3);
+  for (unsigned seed = 0; seed < 4; seed++) {
+    vector<int> arr = random_array(200000, INT_MIN, 1000, seed);
+    vector<int> expected = arr;
+    std::sort(expected.begin(), expected.end());
+    parallel_sort(arr, pool);
+    REQUIRE(arr == expected);
+  }
+}
@@ -0,0 +1,178 @@
+/* ====================================================================================
+   This file contains a parallel sort for vector<int>: a recursive sample sort whose
+   tasks run on a WorkStealingPool (see work_stealing_pool.h).
+
+   One level of the sample sort:
+     1. Draw SAMPLE_OVERSAMPLING * k random elements, sort them and keep every
+        SAMPLE_OVERSAMPLING-th one as a splitter. Duplicate splitters are merged.
+     2. Split the input into blocks. In parallel, every block classifies its elements
+        and counts how many fall into each bucket. The buckets are, in order:
+          < s0, == s0, (s0, s1), == s1, ..., (s_{m-1}, INT_MAX), == INT_MAX
+        Classification is a branchless binary search over the splitters.
+     3. Prefix sums over (bucket, block) give every block a private output slice in
+        each bucket, so the blocks scatter their elements into a scratch buffer in
+        parallel without synchronization.
+     4. Every bucket becomes a task: it copies its elements back and sorts them, with
+        the serial introsort (quick_sort.h) below PARALLEL_SORT_GRAIN elements, with
+        another sample sort level above it. `==` buckets hold equal keys and need no
+        sorting, so inputs with many duplicates never degrade.
+
+   Equal ints are indistinguishable, so the result is exactly std::sort's.
+
+   Memory: one scratch buffer of n ints, allocated once.
+   Indices are size_t, so arrays with more than INT_MAX elements are supported; the
+   serial introsort is only called on buckets of at most PARALLEL_SORT_GRAIN elements.
+
+   @param arr:       the array to sort
+   @param n_threads: the number of threads, hardware_concurrency() if <= 0
+=====================================================================================*/
+
+#ifndef PARALLEL_SORT_H
+#define PARALLEL_SORT_H
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "quick_sort.h"
+#include "work_stealing_pool.h"
+
+const std::size_t PARALLEL_SORT_GRAIN = 1 << 16;
+const std::size_t PARALLEL_SORT_BLOCK = 1 << 16;  // minimum classification block
+const int SAMPLE_SORT_MAX_SPLITTERS = 255;
+const int SAMPLE_OVERSAMPLING = 16;
+
+// Advances seed and returns the next splitmix64 value.
+inline uint64_t splitmix64(uint64_t& seed) {
+  seed += 0x9e3779b97f4a7c15ULL;
+  uint64_t z = seed;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+// Returns the number of splitters < x, i.e. the lower_bound of x in the m + 1
+// sorted splitters (the last one is an INT_MAX sentinel). No data-dependent branch.
+inline std::size_t splitter_lower_bound(const int* splitters, std::size_t m, int x) {
+  const int* base = splitters;
+  std::size_t len = m + 1;
+  while (len > 1) {
+    std::size_t half = len / 2;
+    base = (base[half] < x) ? base + half : base;
+    len -= half;
+  }
+  return (base - splitters) + (*base < x);
+}
+
+inline std::size_t sample_bucket_of(const int* splitters, std::size_t m, int x) {
+  std::size_t j = splitter_lower_bound(splitters, m, x);
+  return 2 * j + (splitters[j] == x);
+}
+
+// Sorts arr[0..n) in place, using tmp[0..n) as scratch.
+inline void sample_sort(int* arr, int* tmp, std::size_t n, WorkStealingPool& pool,
+                        uint64_t seed) {
+  if (n <= PARALLEL_SORT_GRAIN) {
+    quick_sort(arr, 0, static_cast<int>(n) - 1);
+    return;
+  }
+
+  // 1. Splitters from a random sample.
+  std::size_t k = std::min<std::size_t>(SAMPLE_SORT_MAX_SPLITTERS + 1, n / PARALLEL_SORT_GRAIN + 1);
+  std::vector<int> sample(k * SAMPLE_OVERSAMPLING);
+  for (int& x : sample) x = arr[splitmix64(seed) % n];
+  quick_sort(sample.data(), 0, sample.size() - 1);
+
+  std::vector<int> splitters;
+  for (std::size_t i = SAMPLE_OVERSAMPLING; i < sample.size(); i += SAMPLE_OVERSAMPLING) {
+    if (splitters.empty() || splitters.back() != sample[i]) splitters.push_back(sample[i]);
+  }
+  std::size_t m = splitters.size();
+  splitters.push_back(INT_MAX);
+  std::size_t n_buckets = 2 * m + 2;
+
+  // 2. Count per block and bucket. A few blocks per thread balance the load
+  // without making the count table large.
+  std::size_t block = std::max(PARALLEL_SORT_BLOCK, n / (4 * pool.size()) + 1);
+  std::size_t n_blocks = (n + block - 1) / block;
+  std::vector<std::size_t> counts(n_blocks * n_buckets, 0);
+  const int* s = splitters.data();
+
+  TaskGroup count_group;
+  for (std::size_t b = 0; b < n_blocks; b++) {
+    pool.spawn(count_group, [=, &counts] {
+      std::size_t* c = counts.data() + b * n_buckets;
+      std::size_t end = std::min(n, (b + 1) * block);
+      for (std::size_t i = b * block; i < end; i++) c[sample_bucket_of(s, m, arr[i])]++;
+    });
+  }
+  pool.wait(count_group);
+
+  // 3. Exclusive prefix sums, bucket-major, so that each bucket is contiguous.
+  std::vector<std::size_t> bucket_start(n_buckets + 1, 0);
+  std::size_t offset = 0;
+  for (std::size_t bucket = 0; bucket < n_buckets; bucket++) {
+    bucket_start[bucket] = offset;
+    for (std::size_t b = 0; b < n_blocks; b++) {
+      std::size_t c = counts[b * n_buckets + bucket];
+      counts[b * n_buckets + bucket] = offset;
+      offset += c;
+    }
+  }
+  bucket_start[n_buckets] = n;
+
+  TaskGroup scatter_group;
+  for (std::size_t b = 0; b < n_blocks; b++) {
+    pool.spawn(scatter_group, [=, &counts] {
+      std::size_t* out = counts.data() + b * n_buckets;
+      std::size_t end = std::min(n, (b + 1) * block);
+      for (std::size_t i = b * block; i < end; i++) {
+        tmp[out[sample_bucket_of(s, m, arr[i])]++] = arr[i];
+      }
+    });
+  }
+  pool.wait(scatter_group);
+
+  // 4. Copy every bucket back and sort it.
+  TaskGroup bucket_group;
+  for (std::size_t bucket = 0; bucket < n_buckets; bucket++) {
+    std::size_t begin = bucket_start[bucket], len = bucket_start[bucket + 1] - begin;
+    if (len == 0) continue;
+
+    bool equal_keys = bucket % 2 == 1;
+    uint64_t bucket_seed = seed ^ (bucket * 0x9e3779b97f4a7c15ULL);
+    pool.spawn(bucket_group, [=, &pool] {
+      std::memcpy(arr + begin, tmp + begin, len * sizeof(int));
+      if (!equal_keys) sample_sort(arr + begin, tmp + begin, len, pool, bucket_seed);
+    });
+  }
+  pool.wait(bucket_group);
+}
+
+inline void parallel_sort(int* arr, std::size_t n, WorkStealingPool& pool) {
+  if (n <= PARALLEL_SORT_GRAIN || (pool.size() == 1 && n <= INT_MAX)) {
+    quick_sort(arr, 0, static_cast<int>(n) - 1);
+    return;
+  }
+
+  std::vector<int> tmp(n);
+  sample_sort(arr, tmp.data(), n, pool, n);
+}
+
+inline void parallel_sort(std::vector<int>& arr, WorkStealingPool& pool) {
+  parallel_sort(arr.data(), arr.size(), pool);
+}
+
+inline void parallel_sort(std::vector<int>& arr, int n_threads = 0) {
+  if (arr.size() <= PARALLEL_SORT_GRAIN || (n_threads == 1 && arr.size() <= INT_MAX)) {
+    quick_sort(arr.data(), 0, static_cast<int>(arr.size()) - 1);
+    return;
+  }
+
+  WorkStealingPool pool(n_threads);
+  parallel_sort(arr, pool);
+}
+
+#endif // end of parallel_sort.h definition
@@ -0,0 +1,254 @@
+/* ====================================================================================
+   This file contains the partition routines shared by quick_sort.h and quick_select.
+
+   - partition(arr, left, right): Lomuto partition around arr[right]. Elements <= pivot
+     end up on its left, and it returns the pivot's final index. The loop swaps
+     unconditionally and advances the boundary by the result of the comparison, so
+     it has no data-dependent branch.
+
+   - block_partition_right(arr, lp, rp): partitions around the pivot in arr[lp]
+     (smaller elements left, elements >= pivot right), as in BlockQuicksort and
+     pdqsort. Instead of branching on every comparison, it scans a block of
+     BLOCK_SIZE elements from each end and writes the offsets of misplaced elements
+     into small buffers (`offsets[num] = i; num += misplaced;` is branch free), then
+     swaps the recorded pairs in bulk. On random keys this avoids the ~50% branch
+     misprediction rate of the classic Hoare/Lomuto loops.
+     It also reports whether the range was already partitioned (no swap was needed),
+     which quick_sort uses to detect sorted runs.
+
+   - simd_partition_right(arr, lp, rp): the same contract as block_partition_right,
+     but the unpartitioned middle of the range goes through simd_partition() (see
+     simd_sort.h). partition() also switches to simd_partition() for ranges of at
+     least SIMD_PARTITION_THRESHOLD elements when the CPU supports AVX2.
+
+   - partition_left(arr, lp, rp): like block_partition_right, but elements equal to
+     the pivot go left. Used for ranges whose elements are all >= the pivot.
+
+   Both pivot-in-arr[lp] partitions need an element >= pivot in arr[lp+1..rp], which
+   median-of-three pivot selection guarantees.
+=====================================================================================*/
+
+#ifndef PARTITION_H
+#define PARTITION_H
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "simd_sort.h"
+
+const int BLOCK_SIZE = 64;
+const int SIMD_PARTITION_THRESHOLD = 32;
+
+inline int partition(std::vector<int>& arr, int left, int right) {
+  // Uses Lomuto partition scheme
+  int pivot = arr[right];
+
+  if (SIMD_LEVEL != SimdLevel::Scalar && right - left >= SIMD_PARTITION_THRESHOLD) {
+    // x <= pivot is x < pivot + 1, unless pivot is INT_MAX and everything is <= pivot.
+    int i = pivot == INT_MAX ? right : simd_partition(arr.data(), left, right, pivot + 1);
+    std::swap(arr[i], arr[right]);
+    return i;
+  }
+
+  int i = left;
+
+  for (int j = left; j < right; ++j) {
+    int x = arr[j];
+    arr[j] = arr[i];
+    arr[i] = x;
+    i += (x <= pivot);
+  }
+  std::swap(arr[i], arr[right]);
+  return i;
+}
+
+// Swaps arr[first + offsets_l[i]] with arr[last - offsets_r[i]] for i < num. Unless
+// the two blocks mismatch exactly (use_swaps), it rotates the elements through a
+// single temporary, which does one move per element instead of three.
+inline void swap_offsets(int* arr, int first, int last,
+                         const unsigned char* offsets_l, const unsigned char* offsets_r,
+                         int num, bool use_swaps) {
+  if (use_swaps) {
+    // Needed for descending input, where a cyclic rotation would not put the
+    // elements back in order.
+    for (int i = 0; i < num; i++) {
+      std::swap(arr[first + offsets_l[i]], arr[last - offsets_r[i]]);
+    }
+  }
+  else if (num > 0) {
+    int l = first + offsets_l[0];
+    int r = last - offsets_r[0];
+    int tmp = arr[l];
+    arr[l] = arr[r];
+    for (int i = 1; i < num; i++) {
+      l = first + offsets_l[i];
+      arr[r] = arr[l];
+      r = last - offsets_r[i];
+      arr[l] = arr[r];
+    }
+    arr[r] = tmp;
+  }
+}
+
+/**
+ * @brief Partition arr[lp..rp] around arr[lp] with the branchless block kernel.
+ * @return {pivot_pos, already_partitioned}: the final position of the pivot, and
+ *         whether the range was already partitioned before the call.
+ */
+inline std::pair<int, bool> block_partition_right(int* arr, int lp, int rp) {
+  int pivot = arr[lp];
+  int first = lp, last = rp + 1;
+
+  // Find the first pair of misplaced elements, as in the classic Hoare loop.
+  while (arr[++first] < pivot);
+  if (first - 1 == lp) {
+    while (first < last && !(arr[--last] < pivot));
+  }
+  else {
+    while (!(arr[--last] < pivot));
+  }
+
+  bool already_partitioned = first >= last;
+  if (!already_partitioned) {
+    std::swap(arr[first], arr[last]);
+    ++first;
+
+    // arr[first..last) is still unknown. offsets_l holds the offsets (from
+    // offsets_l_base) of elements >= pivot on the left, offsets_r the offsets (back
+    // from offsets_r_base) of elements < pivot on the right.
+    alignas(64) unsigned char offsets_l[BLOCK_SIZE];
+    alignas(64) unsigned char offsets_r[BLOCK_SIZE];
+    int offsets_l_base = first, offsets_r_base = last;
+    int num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+
+    while (first < last) {
+      // Refill whichever buffer ran empty. Near the end, split what is left.
+      int num_unknown = last - first;
+      int left_split = num_l == 0 ? (num_r == 0 ? num_unknown / 2 : num_unknown) : 0;
+      int right_split = num_r == 0 ? (num_unknown - left_split) : 0;
+
+      if (left_split >= BLOCK_SIZE) {
+        for (int i = 0; i < BLOCK_SIZE;) {
+          offsets_l[num_l] = i++; num_l += !(arr[first] < pivot); ++first;
+          offsets_l[num_l] = i++; num_l += !(arr[first] < pivot); ++first;
+          offsets_l[num_l] = i++; num_l += !(arr[first] < pivot); ++first;
+          offsets_l[num_l] = i++; num_l += !(arr[first] < pivot); ++first;
+        }
+      }
+      else {
+        for (int i = 0; i < left_split;) {
+          offsets_l[num_l] = i++; num_l += !(arr[first] < pivot); ++first;
+        }
+      }
+
+      if (right_split >= BLOCK_SIZE) {
+        for (int i = 0; i < BLOCK_SIZE;) {
+          offsets_r[num_r] = ++i; num_r += arr[--last] < pivot;
+          offsets_r[num_r] = ++i; num_r += arr[--last] < pivot;
+          offsets_r[num_r] = ++i; num_r += arr[--last] < pivot;
+          offsets_r[num_r] = ++i; num_r += arr[--last] < pivot;
+        }
+      }
+      else {
+        for (int i = 0; i < right_split;) {
+          offsets_r[num_r] = ++i; num_r += arr[--last] < pivot;
+        }
+      }
+
+      // Swap as many misplaced pairs as both buffers have.
+      int num = std::min(num_l, num_r);
+      swap_offsets(arr, offsets_l_base, offsets_r_base, offsets_l + start_l,
+                   offsets_r + start_r, num, num_l == num_r);
+      num_l -= num; num_r -= num;
+      start_l += num; start_r += num;
+
+      if (num_l == 0) {
+        start_l = 0;
+        offsets_l_base = first;
+      }
+      if (num_r == 0) {
+        start_r = 0;
+        offsets_r_base = last;
+      }
+    }
+
+    // The unknown range is empty, but one buffer may still hold misplaced elements.
+    // Move them next to the boundary.
+    if (num_l) {
+      while (num_l--) std::swap(arr[offsets_l_base + offsets_l[start_l + num_l]], arr[--last]);
+      first = last;
+    }
+    if (num_r) {
+      while (num_r--) std::swap(arr[offsets_r_base - offsets_r[start_r + num_r]], arr[first++]);
+      last = first;
+    }
+  }
+
+  int pivot_pos = first - 1;
+  arr[lp] = arr[pivot_pos];
+  arr[pivot_pos] = pivot;
+  return {pivot_pos, already_partitioned};
+}
+
+/**
+ * @brief Same contract as block_partition_right(), using simd_partition() for the
+ *        part of the range that is not already partitioned.
+ */
+inline std::pair<int, bool> simd_partition_right(int* arr, int lp, int rp) {
+  int pivot = arr[lp];
+  int first = lp, last = rp + 1;
+
+  // Skip the prefix that is already < pivot and the suffix that is already >= pivot.
+  // If they meet, the range was already partitioned.
+  while (arr[++first] < pivot);
+  if (first - 1 == lp) {
+    while (first < last && !(arr[--last] < pivot));
+  }
+  else {
+    while (!(arr[--last] < pivot));
+  }
+
+  bool already_partitioned = first >= last;
+  if (!already_partitioned) {
+    first = simd_partition(arr, first, last + 1, pivot);
+  }
+
+  int pivot_pos = first - 1;
+  arr[lp] = arr[pivot_pos];
+  arr[pivot_pos] = pivot;
+  return {pivot_pos, already_partitioned};
+}
+
+/**
+ * @brief Partition arr[lp..rp] around arr[lp], putting elements equal to the pivot
+ *        on the left.
+ * @return The final position of the pivot. Every element after it is > pivot.
+ */
+inline int partition_left(int* arr, int lp, int rp) {
+  int pivot = arr[lp];
+  int first = lp, last = rp + 1;
+
+  while (pivot < arr[--last]);
+  if (last == rp) {
+    while (first < last && !(pivot < arr[++first]));
+  }
+  else {
+    while (!(pivot < arr[++first]));
+  }
+
+  while (first < last) {
+    std::swap(arr[first], arr[last]);
+    while (pivot < arr[--last]);
+    while (!(pivot < arr[++first]));
+  }
+
+  int pivot_pos = last;
+  arr[lp] = arr[pivot_pos];
+  arr[pivot_pos] = pivot;
+  return pivot_pos;
+}
+
+#endif // end of partition.h definition
@@ -4,40 +4,9 @@
 #include "bits/stdc++.h"
 using namespace std;
 
-int partition(vector<int>& arr, int left, int right) {
-    // Uses Lomuto partition scheme
-    int pivot = arr[right];
-    int i = left;
-
-    for (int j = left; j < right; ++j) {
-        if (arr[j] <= pivot) {
-            swap(arr[i], arr[j]);
-            i++;
-        }
-    }
-    swap(arr[i], arr[right]);
-    return i;
-}
-
-int quick_select(vector<int>& arr, int left, int right, int k) {
-    int pivot_index = partition(arr, left, right);
+#include "quick_select.h"
+#include "test_util.h"
 
-    if (k == pivot_index) {
-        return arr[k];
-    } else if (k < pivot_index) {
-        return quick_select(arr, left, pivot_index - 1, k);
-    } else {
-        return quick_select(arr, pivot_index + 1, right, k);
-    }
-}
-
-int find_kth_smallest(std::vector<int>& arr, int k) {
-  return quick_select(arr, 0, arr.size()-1, k);
-}
-
-int find_kth_largest(std::vector<int>& arr, int k) {
-  return quick_select(arr, 0, arr.size()-1, arr.size() - k);
-}
 
 TEST_CASE("Partition function", "[partition]") {
     vector<int> arr = {3, 2, 1, 5, 4};
@@ -77,3 +46,69 @@ TEST_CASE("Quick Select function", "[quick_select]") {
         REQUIRE(quick_select(arr, 0, arr.size() - 1, arr.size() - 1) == *max_element(arr.begin(), arr.end()));
     }
 }
+
+TEST_CASE("quick_select on large and adversarial inputs", "[quick_select]") {
+    int n = 100001;
+    vector<vector<int>> inputs = {
+        random_array(n, 0, 1000000, 1),
+        random_array(n, 0, 10, 2),
+        vector<int>(n, 7),
+        sorted_array(n),
+        reversed_array(n),
+        organ_pipe_array(n),
+    };
+
+    for (const vector<int>& input : inputs) {
+        vector<int> expected = input;
+        std::sort(expected.begin(), expected.end());
+
+        for (int k : {0, 1, n / 100, n / 2, n - 2, n - 1}) {
+            vector<int> arr = input;
+            REQUIRE(quick_select(arr, 0, n - 1, k) == expected[k]);
+            REQUIRE(*max_element(arr.begin(), arr.begin() + k + 1) == arr[k]);
+            REQUIRE(*min_element(arr.begin() + k, arr.end()) == arr[k]);
+        }
+
+        vector<int> arr = input;
+        REQUIRE(find_kth_largest(arr, 1) == expected[n - 1]);
+    }
+}
+
+TEST_CASE("median_of_medians_select function", "[quick_select]") {
+    for (int n : {1, 5, 64, 65, 1000, 50000}) {
+        vector<int> input = random_array(n, 0, n / 3, n);
+        vector<int> expected = input;
+        std::sort(expected.begin(), expected.end());
+
+        for (int k : {0, n / 3, n - 1}) {
+            vector<int> arr = input;
+            median_of_medians_select(arr.data(), 0, n - 1, k);
+            REQUIRE(arr[k] == expected[k]);
+        }
+    }
+}
+
+TEST_CASE("multi_select function", "[quick_select]") {
+    vector<int> empty;
+    REQUIRE(multi_select(empty, {}).empty());
+    REQUIRE_THROWS_AS(multi_select(empty, {0}), out_of_range);
+
+    vector<int> small = {3, 1, 2};
+    REQUIRE_THROWS_AS(multi_select(small, {1, 3}), out_of_range);
+    REQUIRE_THROWS_AS(multi_select(small, {-1}), out_of_range);
+    REQUIRE(multi_select(small, {2, 0}) == vector<int>{3, 1});
+
+    for (int n : {1, 50, 1000, 200000}) {
+        vector<int> arr = random_array(n, 0, n, n);
+        vector<int> expected = arr;
+        std::sort(expected.begin(), expected.end());
+
+        // p99, p50, p90, a duplicate and both ends, in no particular order.
+        vector<int> ranks = {n * 99 / 100, n / 2, n * 9 / 10, n / 2, 0, n - 1};
+        vector<int> result = multi_select(arr, ranks);
+        for (size_t i = 0; i < ranks.size(); i++) {
+            REQUIRE(result[i] == expected[ranks[i]]);
+            REQUIRE(arr[ranks[i]] == expected[ranks[i]]);
+        }
+    }
+}
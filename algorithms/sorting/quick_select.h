@@ -0,0 +1,216 @@
+/* ====================================================================================
+   This file contains the selection algorithms behind `quick_select()`: finding the
+   element that would be at index k if the range were sorted, without sorting it.
+
+   - Pivot: for ranges above FLOYD_RIVEST_THRESHOLD elements, Floyd-Rivest sampling.
+     A sample of about n^(2/3) elements, taken at a fixed stride across the range,
+     is gathered around k and selected recursively, so that the pivot is an element
+     just below (or above) the k-th one and the partition leaves only a sliver of
+     the range to continue in. The expected cost is about n + min(k, n - k)
+     comparisons, against roughly 3.4n for quick select with a random pivot.
+     Smaller ranges use the median of three or the ninther (see choose_pivot() in
+     quick_sort.h).
+   - Partitioning: three_way_partition() splits the range into < pivot, == pivot and
+     > pivot with two simd_partition() passes, so runs of equal keys end the search
+     at once instead of degrading it.
+   - Worst case (introselect): once the ranges partitioned so far add up to
+     SELECT_WORK_FACTOR * n elements, the rest of the search switches to the median
+     of medians pivot (groups of five), which guarantees a 30/70 split, so
+     selection is O(n) in the worst case. Typical input, including sorted and
+     reverse-sorted arrays, partitions about n + o(n) elements and never gets there.
+   - Small ranges (<= SIMD_SORT_THRESHOLD elements) are sorted, with a SIMD network
+     when the CPU supports it.
+
+   After floyd_rivest_select(arr, left, right, k), arr[k] holds the k-th smallest
+   element of arr[left..right], every element before it is <= arr[k] and every
+   element after it is >= arr[k].
+
+   multi_select(arr, ranks) finds several order statistics in one pass: it selects
+   the middle rank, then recurses into the left part with the smaller ranks and
+   into the right part with the larger ones. m ranks cost O(n log m) instead of
+   the O(n m) of m separate calls, e.g. for p50, p90 and p99 of the same array.
+   A rank outside [0, arr.size()) throws std::out_of_range.
+
+   @param arr:   the array to select from
+   @param left:  the index of the first element of the range
+   @param right: the index of the last element of the range
+   @param k:     the index of the element to find (left <= k <= right)
+=====================================================================================*/
+
+#ifndef QUICK_SELECT_H
+#define QUICK_SELECT_H
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "quick_sort.h"
+
+const int FLOYD_RIVEST_THRESHOLD = 600;
+const int MEDIAN_OF_MEDIANS_GROUP = 5;
+const int SELECT_WORK_FACTOR = 4;
+
+/**
+ * @brief Partition arr[left..right] into < pivot, == pivot and > pivot.
+ * @return {lt, gt}: arr[left..lt) < pivot, arr[lt..gt) == pivot, arr[gt..right] > pivot.
+ */
+inline std::pair<int, int> three_way_partition(int* arr, int left, int right, int pivot) {
+  int lt = simd_partition(arr, left, right + 1, pivot);
+
+  // x <= pivot is x < pivot + 1, unless pivot is INT_MAX and everything is <= pivot.
+  int gt = pivot == INT_MAX ? right + 1 : simd_partition(arr, lt, right + 1, pivot + 1);
+  return {lt, gt};
+}
+
+inline void sort_small(int* arr, int left, int right) {
+  if (SIMD_LEVEL != SimdLevel::Scalar && right - left + 1 <= SIMD_SORT_THRESHOLD) {
+    simd_sort_small(arr + left, right - left + 1);
+  }
+  else {
+    insertion_sort(arr, left, right);
+  }
+}
+
+inline void median_of_medians_select(int* arr, int left, int right, int k);
+
+// Returns the median of the medians of groups of five, moving the group medians to
+// the front of the range on the way.
+inline int median_of_medians(int* arr, int left, int right) {
+  int groups = 0;
+  for (int i = left; i <= right; i += MEDIAN_OF_MEDIANS_GROUP) {
+    int last = std::min(i + MEDIAN_OF_MEDIANS_GROUP - 1, right);
+    insertion_sort(arr, i, last);
+    std::swap(arr[left + groups++], arr[i + (last - i) / 2]);
+  }
+  int mid = left + (groups - 1) / 2;
+  median_of_medians_select(arr, left, left + groups - 1, mid);
+  return arr[mid];
+}
+
+/**
+ * @brief Selection with the median of medians pivot: O(n) in the worst case.
+ */
+inline void median_of_medians_select(int* arr, int left, int right, int k) {
+  while (right - left + 1 > SIMD_SORT_THRESHOLD) {
+    auto [lt, gt] = three_way_partition(arr, left, right, median_of_medians(arr, left, right));
+    if (k < lt) right = lt - 1;
+    else if (k >= gt) left = gt;
+    else return;
+  }
+  sort_small(arr, left, right);
+}
+
+/**
+ * @brief Floyd-Rivest selection with the median of medians fallback.
+ */
+inline void floyd_rivest_select(int* arr, int left, int right, int k) {
+  // Introselect: every step partitions the whole remaining range, so bounding the
+  // total size of those ranges bounds the work.
+  long long budget = SELECT_WORK_FACTOR * static_cast<long long>(right - left + 1);
+
+  while (right - left + 1 > SIMD_SORT_THRESHOLD) {
+    int n = right - left + 1;
+    budget -= n;
+    if (budget < 0) return median_of_medians_select(arr, left, right, k);
+
+    int pivot;
+    if (n > FLOYD_RIVEST_THRESHOLD) {
+      // Select k within a sample around it, sized and placed so that the k-th
+      // element of the range is very likely inside it. The sample is first filled
+      // with elements taken at a fixed stride across the range, so that it is
+      // representative even for sorted, reversed or otherwise patterned input.
+      double i = k - left + 1;
+      double z = std::log(n);
+      double s = 0.5 * std::exp(2 * z / 3);
+      double sd = 0.5 * std::sqrt(z * s * (n - s) / n) * (i < n / 2.0 ? -1 : 1);
+      int sample_left = std::max(left, static_cast<int>(k - i * s / n + sd));
+      int sample_right = std::min(right, static_cast<int>(k + (n - i) * s / n + sd));
+
+      int m = sample_right - sample_left + 1;
+      for (int j = 0; j < m; j++) {
+        std::swap(arr[sample_left + j], arr[left + static_cast<long long>(j) * n / m]);
+      }
+      floyd_rivest_select(arr, sample_left, sample_right, k);
+      pivot = arr[k];
+    }
+    else {
+      choose_pivot(arr, left, right);
+      pivot = arr[left];
+    }
+
+    auto [lt, gt] = three_way_partition(arr, left, right, pivot);
+    if (k < lt) right = lt - 1;
+    else if (k >= gt) left = gt;
+    else return;
+  }
+  sort_small(arr, left, right);
+}
+
+// Selects the ranks ranks[lo..hi) (sorted) within arr[left..right].
+inline void multi_select(int* arr, int left, int right, const std::vector<int>& ranks,
+                         int lo, int hi) {
+  while (lo < hi) {
+    // A sorted range answers every rank in it.
+    if (right - left + 1 <= SIMD_SORT_THRESHOLD) return sort_small(arr, left, right);
+
+    int mid = lo + (hi - lo) / 2;
+    int k = ranks[mid];
+    floyd_rivest_select(arr, left, right, k);
+
+    // Recurse into the side with fewer ranks, loop on the other.
+    if (mid - lo < hi - mid - 1) {
+      multi_select(arr, left, k - 1, ranks, lo, mid);
+      left = k + 1;
+      lo = mid + 1;
+    }
+    else {
+      multi_select(arr, k + 1, right, ranks, mid + 1, hi);
+      right = k - 1;
+      hi = mid;
+    }
+  }
+}
+
+/**
+ * @brief Find the element that would be at index k if arr[left..right] were sorted.
+ */
+inline int quick_select(std::vector<int>& arr, int left, int right, int k) {
+  floyd_rivest_select(arr.data(), left, right, k);
+  return arr[k];
+}
+
+/**
+ * @brief Find several order statistics of arr at once.
+ * @param ranks Indices into the sorted order, in any order, duplicates allowed.
+ * @return The element at each rank, in the order of ranks.
+ * @throws std::out_of_range if a rank is not in [0, arr.size()).
+ */
+inline std::vector<int> multi_select(std::vector<int>& arr, const std::vector<int>& ranks) {
+  std::vector<int> sorted_ranks = ranks;
+  std::sort(sorted_ranks.begin(), sorted_ranks.end());
+  sorted_ranks.erase(std::unique(sorted_ranks.begin(), sorted_ranks.end()), sorted_ranks.end());
+  if (sorted_ranks.empty()) return {};
+  if (sorted_ranks.front() < 0 || sorted_ranks.back() >= static_cast<int>(arr.size())) {
+    throw std::out_of_range("multi_select: rank out of range");
+  }
+
+  multi_select(arr.data(), 0, arr.size() - 1, sorted_ranks, 0, sorted_ranks.size());
+
+  std::vector<int> result;
+  result.reserve(ranks.size());
+  for (int k : ranks) result.push_back(arr[k]);
+  return result;
+}
+
+inline int find_kth_smallest(std::vector<int>& arr, int k) {
+  return quick_select(arr, 0, arr.size() - 1, k);
+}
+
+inline int find_kth_largest(std::vector<int>& arr, int k) {
+  return quick_select(arr, 0, arr.size() - 1, arr.size() - k);
+}
+
+#endif // end of quick_select.h definition
@@ -4,57 +4,9 @@
 #include "bits/stdc++.h"
 using namespace std;
 
-// int partition(vector<int>& arr, int lp, int rp) {
-//   while (lp!=rp) {
-//     if (arr[rp] >= arr[lp]) {
-//       rp--;
-//     }
-
-//     else if (arr[lp+1] <= arr[lp]) {
-//       swap(arr[lp+1], arr[lp]);
-//       lp++;
-//     }
-
-//     else {
-//       swap(arr[lp+1], arr[rp]);
-//     }
-//   }
-//   return lp; // pivot index
-// }
-
-int partition(vector<int>& arr, int left, int right) {
-    // Uses Lomuto partition scheme
-    int pivot = arr[right];
-    int i = left;
-
-    for (int j = left; j < right; ++j) {
-        if (arr[j] <= pivot) {
-            swap(arr[i], arr[j]);
-            i++;
-        }
-    }
-    swap(arr[i], arr[right]);
-    return i;
-}
-
-void quick_sort(vector<int>& arr, int lp, int rp) {
-  // Base case:
-  // 1. partition to sort has only one element (lp == rp)
-  // 2. partition to sort has no element (lp > rp)
-  if (lp >= rp) return;
-
-  // We choose initial pivot as lp (first element in arr)
-  int pivot = partition(arr, lp, rp);
-
-  // Recursively sort left and right partition
-  quick_sort(arr, lp, pivot - 1);
-  quick_sort(arr, pivot + 1, rp);
-}
-
-void sort(vector<int>& arr) {
-  int n = arr.size();
-  quick_sort(arr, 0, n - 1);
-}
+#include "quick_sort.h"
+#include "sort.h"
+#include "test_util.h"
 
 TEST_CASE("partition function") {
   vector<int> arr1 = {3, 1, 2, 5, 4};
@@ -115,3 +67,100 @@ TEST_CASE("sort function with mixed elements") {
   sort(arr);
   REQUIRE(is_sorted(arr.begin(), arr.end()));
 }
+
+
+// Sorts with the int introsort itself and with sort(), which may dispatch elsewhere.
+void require_sorted_like_std(vector<int> arr) {
+  vector<int> expected = arr;
+  std::sort(expected.begin(), expected.end());
+  vector<int> dispatched = arr;
+  quick_sort(arr, 0, static_cast<int>(arr.size()) - 1);
+  REQUIRE(arr == expected);
+  sort(dispatched);
+  REQUIRE(dispatched == expected);
+}
+
+TEST_CASE("sort function with large random inputs") {
+  for (int n : {17, 100, 1000, 100000}) {
+    require_sorted_like_std(random_array(n, 0, INT_MAX, n));
+    require_sorted_like_std(random_array(n, 0, 10, n + 1));
+  }
+}
+
+TEST_CASE("sort function with adversarial patterns") {
+  const int n = 200000;
+
+  vector<int> sawtooth(n);
+  for (int i = 0; i < n; i++) sawtooth[i] = i % 64;
+
+  require_sorted_like_std(sorted_array(n));
+  require_sorted_like_std(reversed_array(n));
+  require_sorted_like_std(vector<int>(n, 7));
+  require_sorted_like_std(organ_pipe_array(n));
+  require_sorted_like_std(sawtooth);
+}
+
+TEST_CASE("quick_sort function on a subrange") {
+  vector<int> arr = random_array(1000, 0, 1000, 42);
+  vector<int> expected = arr;
+  std::sort(expected.begin() + 100, expected.begin() + 900);
+
+  quick_sort(arr, 100, 899);
+  REQUIRE(arr == expected);
+}
+
+TEST_CASE("heap_sort and insertion_sort functions") {
+  vector<int> arr1 = random_array(5000, 0, 100, 7);
+  heap_sort(arr1.data(), arr1.size());
+  REQUIRE(is_sorted(arr1.begin(), arr1.end()));
+
+  vector<int> arr2 = random_array(50, 0, 100, 8);
+  insertion_sort(arr2.data(), 0, arr2.size() - 1);
+  REQUIRE(is_sorted(arr2.begin(), arr2.end()));
+}
+
+TEST_CASE("block_partition_right function") {
+  for (int n : {3, 17, 64, 129, 1000, 10000}) {
+    for (int max_value : {1, 10, INT_MAX}) {
+      vector<int> arr = random_array(n, 0, max_value, n * 31 + max_value);
+      vector<int> before = arr;
+
+      // block_partition_right needs an element >= pivot after it
+      choose_pivot(arr.data(), 0, n - 1);
+      int pivot_value = arr[0];
+      auto [pivot, already_partitioned] = block_partition_right(arr.data(), 0, n - 1);
+
+      REQUIRE(arr[pivot] == pivot_value);
+      for (int i = 0; i < pivot; i++) REQUIRE(arr[i] < pivot_value);
+      for (int i = pivot + 1; i < n; i++) REQUIRE(arr[i] >= pivot_value);
+      REQUIRE(is_permutation(arr.begin(), arr.end(), before.begin()));
+    }
+  }
+
+  vector<int> sorted_arr = {1, 2, 3, 4, 5, 6};
+  REQUIRE(block_partition_right(sorted_arr.data(), 0, 5) == make_pair(0, true));
+}
+
+TEST_CASE("partition_left function") {
+  vector<int> arr = {5, 5, 9, 5, 7, 5, 6, 5};
+  int pivot = partition_left(arr.data(), 0, arr.size() - 1);
+  REQUIRE(arr[pivot] == 5);
+  for (int i = 0; i < pivot; i++) REQUIRE(arr[i] == 5);
+  for (int i = pivot + 1; i < static_cast<int>(arr.size()); i++) REQUIRE(arr[i] > 5);
+}
+
+TEST_CASE("simd_partition_right function") {
+  for (int n : {3, 17, 64, 129, 1000, 10000}) {
+    vector<int> arr = random_array(n, 0, 100, n);
+    vector<int> before = arr;
+
+    choose_pivot(arr.data(), 0, n - 1);
+    int pivot_value = arr[0];
+    auto [pivot, already_partitioned] = simd_partition_right(arr.data(), 0, n - 1);
+
+    REQUIRE(arr[pivot] == pivot_value);
+    for (int i = 0; i < pivot; i++) REQUIRE(arr[i] < pivot_value);
+    for (int i = pivot + 1; i < n; i++) REQUIRE(arr[i] >= pivot_value);
+    REQUIRE(is_permutation(arr.begin(), arr.end(), before.begin()));
+  }
+}
@@ -0,0 +1,202 @@
+/* ====================================================================================
+   This file contains the int quick sort that `sort()` (sort.h) dispatches vectors of
+   ints to. It is an introsort, so it keeps quick sort's speed on typical input but
+   is O(n log n) in the worst case:
+
+   - Pivot: median of three (first, middle, last) for small ranges and Tukey's
+     ninther (median of three medians of three) for ranges above NINTHER_THRESHOLD.
+     Sorted and reverse-sorted input pick the true median instead of an extreme.
+   - Partitioning: block_partition_right() from partition.h, a branchless
+     BlockQuicksort kernel that buffers comparison results and swaps in bulk.
+   - Duplicates: the partition puts elements equal to the pivot on the right. When a
+     range is bounded on the left by an earlier pivot equal to the new pivot, every
+     element in the range is >= pivot, so it partitions the other way instead
+     (equal elements to the left) and skips all of them at once. Runs of equal keys
+     therefore cost linear time, and all-equal input is O(n).
+   - Sorted runs (pdqsort): if a partition needed no swaps, both sides are likely
+     already sorted, so they are insertion sorted with a budget of
+     PARTIAL_INSERTION_SORT_LIMIT moves. If neither side exceeds it, the range is
+     done; sorted and reverse-sorted input is handled in O(n).
+   - Bad partitions (pdqsort): a side smaller than 1/8 of the range counts as a bad
+     partition. After each one, a few elements on both sides are swapped around to
+     break the pattern that fooled the pivot selection, and after log2(n) of them it
+     switches to heap sort.
+   - Small ranges (<= INSERTION_SORT_THRESHOLD elements) are finished with insertion
+     sort.
+   - With AVX2 or AVX-512 (see simd_sort.h), ranges of up to SIMD_SORT_THRESHOLD
+     elements are finished with a SIMD sorting network instead, and the partition
+     step uses the vectorized simd_partition_right().
+   - It recurses only into the smaller side of each partition and loops on the larger
+     one, so the stack depth is O(log n).
+   - After 2 * log2(n) levels of partitioning it also switches to heap sort (the 4-ary
+     heap sort of heap.h), which caps the damage a bad sequence of pivots can do.
+
+   `partition()`, the Lomuto partition around arr[right], lives in partition.h.
+   The helpers take a raw `int*` base so that callers sorting parts of a larger
+   buffer (see parallel_sort.h) can pass the start of their range.
+
+   @param arr: the array to sort
+   @param lp:  the index of the first element of the range to sort
+   @param rp:  the index of the last element of the range to sort
+=====================================================================================*/
+
+#ifndef QUICK_SORT_H
+#define QUICK_SORT_H
+
+#include <algorithm>
+#include <bit>
+#include <utility>
+#include <vector>
+
+#include "heap.h"
+#include "partition.h"
+
+const int INSERTION_SORT_THRESHOLD = 16;
+const int NINTHER_THRESHOLD = 128;
+const int PARTIAL_INSERTION_SORT_LIMIT = 8;
+
+inline void insertion_sort(int* arr, int lp, int rp) {
+  for (int i = lp + 1; i <= rp; i++) {
+    int key = arr[i];
+    int j = i - 1;
+    while (j >= lp && key < arr[j]) {
+      arr[j + 1] = arr[j];
+      j--;
+    }
+    arr[j + 1] = key;
+  }
+}
+
+// Sorts arr[a], arr[b], arr[c] in place, so that arr[b] is their median.
+inline void sort3(int* arr, int a, int b, int c) {
+  if (arr[b] < arr[a]) std::swap(arr[a], arr[b]);
+  if (arr[c] < arr[b]) std::swap(arr[b], arr[c]);
+  if (arr[b] < arr[a]) std::swap(arr[a], arr[b]);
+}
+
+// Moves the pivot (median of three or ninther) to arr[lp].
+inline void choose_pivot(int* arr, int lp, int rp) {
+  int n = rp - lp + 1;
+  int mid = lp + n / 2;
+  if (n > NINTHER_THRESHOLD) {
+    sort3(arr, lp, mid, rp);
+    sort3(arr, lp + 1, mid - 1, rp - 1);
+    sort3(arr, lp + 2, mid + 1, rp - 2);
+    sort3(arr, mid - 1, mid, mid + 1);
+    std::swap(arr[lp], arr[mid]);
+  }
+  else {
+    sort3(arr, mid, lp, rp);
+  }
+}
+
+// Insertion sorts arr[lp..rp], but gives up once more than
+// PARTIAL_INSERTION_SORT_LIMIT elements have been moved. Returns true if the range
+// ended up sorted.
+inline bool partial_insertion_sort(int* arr, int lp, int rp) {
+  int moved = 0;
+  for (int i = lp + 1; i <= rp; i++) {
+    int key = arr[i];
+    int j = i - 1;
+    while (j >= lp && key < arr[j]) {
+      arr[j + 1] = arr[j];
+      j--;
+    }
+    arr[j + 1] = key;
+
+    moved += i - (j + 1);
+    if (moved > PARTIAL_INSERTION_SORT_LIMIT) return false;
+  }
+  return true;
+}
+
+// Swaps a few elements of arr[lp..rp] with elements a quarter of the way in, so
+// that the next pivot is drawn from different positions.
+inline void break_patterns(int* arr, int lp, int rp) {
+  int n = rp - lp + 1;
+  if (n < INSERTION_SORT_THRESHOLD) return;
+
+  int q = n / 4;
+  std::swap(arr[lp], arr[lp + q]);
+  std::swap(arr[rp], arr[rp - q]);
+  if (n > NINTHER_THRESHOLD) {
+    std::swap(arr[lp + 1], arr[lp + q + 1]);
+    std::swap(arr[lp + 2], arr[lp + q + 2]);
+    std::swap(arr[rp - 1], arr[rp - q - 1]);
+    std::swap(arr[rp - 2], arr[rp - q - 2]);
+  }
+}
+
+// `leftmost` is false when arr[lp-1] belongs to the array and is <= every element
+// of arr[lp..rp] (it is the pivot of an enclosing partition).
+inline void introsort_loop(int* arr, int lp, int rp, int depth_limit,
+                           int bad_allowed, bool leftmost) {
+  while (rp - lp + 1 > INSERTION_SORT_THRESHOLD) {
+    if (SIMD_LEVEL != SimdLevel::Scalar && rp - lp + 1 <= SIMD_SORT_THRESHOLD) {
+      simd_sort_small(arr + lp, rp - lp + 1);
+      return;
+    }
+
+    if (depth_limit == 0) {
+      heap_sort(arr + lp, rp - lp + 1);
+      return;
+    }
+    depth_limit--;
+
+    int n = rp - lp + 1;
+    choose_pivot(arr, lp, rp);
+
+    if (!leftmost && !(arr[lp - 1] < arr[lp])) {
+      lp = partition_left(arr, lp, rp) + 1;
+      continue;
+    }
+
+    auto [pivot, already_partitioned] = SIMD_LEVEL != SimdLevel::Scalar
+                                            ? simd_partition_right(arr, lp, rp)
+                                            : block_partition_right(arr, lp, rp);
+    int l_size = pivot - lp, r_size = rp - pivot;
+
+    if (l_size < n / 8 || r_size < n / 8) {
+      if (--bad_allowed == 0) {
+        heap_sort(arr + lp, rp - lp + 1);
+        return;
+      }
+      break_patterns(arr, lp, pivot - 1);
+      break_patterns(arr, pivot + 1, rp);
+    }
+    else if (already_partitioned && partial_insertion_sort(arr, lp, pivot - 1)
+                                 && partial_insertion_sort(arr, pivot + 1, rp)) {
+      return;
+    }
+
+    // Recurse into the smaller side, loop on the larger one.
+    if (l_size < r_size) {
+      introsort_loop(arr, lp, pivot - 1, depth_limit, bad_allowed, leftmost);
+      lp = pivot + 1;
+      leftmost = false;
+    }
+    else {
+      introsort_loop(arr, pivot + 1, rp, depth_limit, bad_allowed, false);
+      rp = pivot - 1;
+    }
+  }
+
+  if (SIMD_LEVEL != SimdLevel::Scalar) simd_sort_small(arr + lp, rp - lp + 1);
+  else insertion_sort(arr, lp, rp);
+}
+
+inline void quick_sort(int* arr, int lp, int rp) {
+  // Base case:
+  // 1. partition to sort has only one element (lp == rp)
+  // 2. partition to sort has no element (lp > rp)
+  if (lp >= rp) return;
+
+  int log_n = std::bit_width(static_cast<unsigned>(rp - lp + 1)) - 1;
+  introsort_loop(arr, lp, rp, 2 * log_n, log_n, true);
+}
+
+inline void quick_sort(std::vector<int>& arr, int lp, int rp) {
+  quick_sort(arr.data(), lp, rp);
+}
+
+#endif // end of quick_sort.h definition
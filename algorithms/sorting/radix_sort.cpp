@@ -0,0 +1,121 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_test_macros.hpp>
+
+#include "bits/stdc++.h"
+#include "radix_sort.h"
+using namespace std;
+
+template <typename T>
+vector<T> random_values(int n, T lo, T hi, unsigned seed) {
+  mt19937_64 rng(seed);
+  vector<T> arr(n);
+  if constexpr (is_floating_point_v<T>) {
+    uniform_real_distribution<T> dist(lo, hi);
+    for (T& x : arr) x = dist(rng);
+  }
+  else {
+    uniform_int_distribution<T> dist(lo, hi);
+    for (T& x : arr) x = dist(rng);
+  }
+  return arr;
+}
+
+template <typename T>
+void require_sorted_like_std(const vector<T>& arr) {
+  vector<T> expected = arr;
+  std::sort(expected.begin(), expected.end());
+
+  vector<T> lsd = arr;
+  radix_sort(lsd);
+  REQUIRE(lsd == expected);
+
+  vector<T> msd = arr;
+  msd_radix_sort(msd);
+  REQUIRE(msd == expected);
+}
+
+TEST_CASE("to_radix_key preserves order") {
+  vector<int> ints = {INT_MIN, -100, -1, 0, 1, 100, INT_MAX};
+  for (size_t i = 0; i + 1 < ints.size(); i++) {
+    REQUIRE(to_radix_key(ints[i]) < to_radix_key(ints[i + 1]));
+  }
+
+  vector<double> doubles = {-numeric_limits<double>::infinity(), -1e300, -2.5, -1e-300,
+                            -0.0, 0.0, 1e-300, 2.5, 1e300, numeric_limits<double>::infinity()};
+  for (size_t i = 0; i + 1 < doubles.size(); i++) {
+    REQUIRE(to_radix_key(doubles[i]) < to_radix_key(doubles[i + 1]));
+  }
+}
+
+TEST_CASE("radix sort with small inputs") {
+  require_sorted_like_std(vector<int>{});
+  require_sorted_like_std(vector<int>{1});
+  require_sorted_like_std(vector<int>{3, 1, 2, 5, 4});
+  require_sorted_like_std(vector<int>{-1, -3, -2, -5, -4});
+  require_sorted_like_std(vector<int>{1, -1, 0, -2, 2});
+  require_sorted_like_std(vector<int>{3, 3, 3, 3, 3});
+}
+
+TEST_CASE("radix sort with integer keys") {
+  for (int n : {100, 1000, 100000}) {
+    require_sorted_like_std(random_values<int>(n, INT_MIN, INT_MAX, n));
+    require_sorted_like_std(random_values<int>(n, 0, 1000, n));
+    require_sorted_like_std(random_values<unsigned>(n, 0, UINT_MAX, n));
+    require_sorted_like_std(random_values<int64_t>(n, INT64_MIN, INT64_MAX, n));
+    require_sorted_like_std(random_values<uint64_t>(n, 0, 1 << 20, n));
+    require_sorted_like_std(random_values<int16_t>(n, INT16_MIN, INT16_MAX, n));
+  }
+}
+
+TEST_CASE("radix sort with floating point keys") {
+  for (int n : {100, 1000, 100000}) {
+    require_sorted_like_std(random_values<float>(n, -1e6f, 1e6f, n));
+    require_sorted_like_std(random_values<double>(n, -1.0, 1.0, n));
+    require_sorted_like_std(random_values<double>(n, 0.0, 1e-300, n));
+  }
+
+  require_sorted_like_std(vector<double>{2.0, -0.5, numeric_limits<double>::infinity(),
+                                         -numeric_limits<double>::infinity(), 0.0, -7.25});
+}
+
+TEST_CASE("radix sort with key-value pairs") {
+  vector<int> keys = random_values<int>(50000, -50, 50, 1);
+  vector<pair<int, int>> arr(keys.size());
+  for (size_t i = 0; i < keys.size(); i++) arr[i] = {keys[i], static_cast<int>(i)};
+
+  vector<pair<int, int>> expected = arr;
+  stable_sort(expected.begin(), expected.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+
+  vector<pair<int, int>> lsd = arr;
+  radix_sort(lsd);
+  REQUIRE(lsd == expected);
+
+  // MSD radix sort is not stable, so only the keys are ordered, and every
+  // payload must still be attached to its key.
+  vector<pair<int, int>> msd = arr;
+  msd_radix_sort(msd);
+  REQUIRE(is_sorted(msd.begin(), msd.end(),
+                    [](const auto& a, const auto& b) { return a.first < b.first; }));
+  REQUIRE(all_of(msd.begin(), msd.end(), [&](const auto& p) { return keys[p.second] == p.first; }));
+
+  vector<pair<double, string>> named = {{2.5, "c"}, {-1.0, "a"}, {2.5, "d"}, {0.0, "b"}};
+  radix_sort(named);
+  REQUIRE(named == vector<pair<double, string>>{{-1.0, "a"}, {0.0, "b"}, {2.5, "c"}, {2.5, "d"}});
+}
+
+TEST_CASE("counting sort with small ranges") {
+  auto require_counting_sorted = [](auto arr, auto lo, auto hi) {
+    auto expected = arr;
+    std::sort(expected.begin(), expected.end());
+    counting_sort(arr.data(), arr.size(), lo, hi);
+    REQUIRE(arr == expected);
+  };
+
+  require_counting_sorted(random_values<int>(10000, -500, 500, 1), -500, 500);
+  require_counting_sorted(random_values<int>(1000, INT_MAX - 10, INT_MAX, 2), INT_MAX - 10, INT_MAX);
+  require_counting_sorted(random_values<int64_t>(1000, INT64_MIN, INT64_MIN + 3, 3), INT64_MIN,
+                          INT64_MIN + 3);
+  require_counting_sorted(vector<int8_t>{5, -128, 127, 0, -1}, int8_t(-128), int8_t(127));
+  require_counting_sorted(vector<unsigned>{}, 0u, 0u);
+}
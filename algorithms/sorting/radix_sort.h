@@ -0,0 +1,251 @@
+/* ====================================================================================
+   This file contains radix sorts for integer and floating point keys.
+
+   Keys are mapped to unsigned integers whose unsigned order is the key order
+   (to_radix_key), so one implementation handles every arithmetic type:
+     - unsigned integers: unchanged
+     - signed integers:   the sign bit is flipped, so negatives come first
+     - floats / doubles:  negatives have all bits flipped (larger magnitude sorts
+                          first), non-negatives have the sign bit set. -0.0 sorts just
+                          before 0.0 and NaNs with the sign bit clear sort last.
+
+   - radix_sort(arr): LSD radix sort with RADIX_BITS (11) bit digits, i.e. 3 passes
+     for 32-bit keys and 6 for 64-bit keys. The histograms of all digits are built in
+     a single read of the input, and a pass is skipped when every key has the same
+     digit there (e.g. the high digits of small non-negative ints), so it is often
+     cheaper than the key width suggests. Stable, needs a buffer of n elements.
+
+   - radix_sort(pairs): the same for vector<pair<Key, Value>>, ordered by key. The
+     payload moves with its key and equal keys keep their input order.
+
+   - msd_radix_sort(arr): in-place MSD radix sort (American flag sort) with 8-bit
+     digits. Each level counts the digit, permutes the elements into their buckets
+     by following cycles, and recurses into every bucket. Buckets of at most
+     MSD_INSERTION_SORT_THRESHOLD elements are finished with insertion sort, and
+     levels where every key has the same digit are skipped. Needs no buffer but is
+     not stable.
+
+   - counting_sort(arr, n, min_key, max_key): for integers that all lie in a small
+     range [min_key, max_key]. Counts every value in one pass and writes the runs of
+     equal values back in a second, so it is O(n + range) and needs a table of
+     range counters. Equal ints are indistinguishable, so it does not need to move
+     elements at all.
+
+   Compared to quick sort these do O(n * passes) work with no comparisons at all,
+   which is why they win on large arrays of uniformly distributed keys.
+
+   @param arr: the array to sort
+=====================================================================================*/
+
+#ifndef RADIX_SORT_H
+#define RADIX_SORT_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+const int RADIX_BITS = 11;
+const int MSD_RADIX_BITS = 8;
+const std::size_t MSD_INSERTION_SORT_THRESHOLD = 32;
+
+// The unsigned integer type to_radix_key() maps T to.
+template <typename T, bool = std::is_floating_point_v<T>>
+struct RadixKey {
+  using type = std::make_unsigned_t<T>;
+};
+
+template <typename T>
+struct RadixKey<T, true> {
+  using type = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+};
+
+template <typename T>
+using radix_key_t = typename RadixKey<T>::type;
+
+/**
+ * @brief Map a key to an unsigned integer with the same order.
+ */
+template <typename T>
+constexpr radix_key_t<T> to_radix_key(T key) {
+  static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>,
+                "radix sort needs integer or floating point keys");
+  using U = radix_key_t<T>;
+  constexpr U sign_bit = U(1) << (sizeof(U) * 8 - 1);
+
+  if constexpr (std::is_floating_point_v<T>) {
+    static_assert(sizeof(T) == sizeof(U), "unsupported floating point type");
+    U bits = std::bit_cast<U>(key);
+    return (bits & sign_bit) ? ~bits : bits | sign_bit;
+  }
+  else if constexpr (std::is_signed_v<T>) {
+    return static_cast<U>(key) ^ sign_bit;
+  }
+  else {
+    return key;
+  }
+}
+
+// Sorts arr[0..n) by key(arr[i]), an unsigned integer, using tmp[0..n) as scratch.
+template <typename T, typename KeyFn>
+void lsd_radix_sort(T* arr, T* tmp, std::size_t n, KeyFn key) {
+  using U = decltype(key(arr[0]));
+  constexpr int KEY_BITS = sizeof(U) * 8;
+  constexpr int PASSES = (KEY_BITS + RADIX_BITS - 1) / RADIX_BITS;
+  constexpr std::size_t BUCKETS = std::size_t(1) << RADIX_BITS;
+  constexpr std::size_t MASK = BUCKETS - 1;
+
+  if (n < 2) return;
+
+  std::vector<std::array<std::size_t, BUCKETS>> counts(PASSES);
+  for (std::size_t i = 0; i < n; i++) {
+    U k = key(arr[i]);
+    for (int pass = 0; pass < PASSES; pass++) {
+      counts[pass][(k >> (pass * RADIX_BITS)) & MASK]++;
+    }
+  }
+
+  T* from = arr;
+  T* to = tmp;
+  for (int pass = 0; pass < PASSES; pass++) {
+    auto& count = counts[pass];
+    int shift = pass * RADIX_BITS;
+
+    // Every key has the same digit here, so this pass would not move anything.
+    if (count[(key(from[0]) >> shift) & MASK] == n) continue;
+
+    std::size_t offset = 0;
+    for (std::size_t& c : count) {
+      std::size_t bucket_size = c;
+      c = offset;
+      offset += bucket_size;
+    }
+
+    for (std::size_t i = 0; i < n; i++) {
+      to[count[(key(from[i]) >> shift) & MASK]++] = std::move(from[i]);
+    }
+    std::swap(from, to);
+  }
+
+  if (from != arr) {
+    for (std::size_t i = 0; i < n; i++) arr[i] = std::move(from[i]);
+  }
+}
+
+template <typename T, typename KeyFn>
+void radix_insertion_sort(T* arr, std::size_t n, KeyFn key) {
+  for (std::size_t i = 1; i < n; i++) {
+    T value = std::move(arr[i]);
+    auto k = key(value);
+    std::size_t j = i;
+    while (j > 0 && k < key(arr[j - 1])) {
+      arr[j] = std::move(arr[j - 1]);
+      j--;
+    }
+    arr[j] = std::move(value);
+  }
+}
+
+// Sorts arr[0..n) by key(arr[i]), looking at the digits at `shift` and below.
+template <typename T, typename KeyFn>
+void msd_radix_sort(T* arr, std::size_t n, int shift, KeyFn key) {
+  constexpr std::size_t BUCKETS = std::size_t(1) << MSD_RADIX_BITS;
+  constexpr std::size_t MASK = BUCKETS - 1;
+
+  if (n <= MSD_INSERTION_SORT_THRESHOLD) {
+    radix_insertion_sort(arr, n, key);
+    return;
+  }
+
+  std::array<std::size_t, BUCKETS> count{};
+  for (std::size_t i = 0; i < n; i++) count[(key(arr[i]) >> shift) & MASK]++;
+
+  // Every key has the same digit here: go straight to the next one.
+  if (count[(key(arr[0]) >> shift) & MASK] == n) {
+    if (shift > 0) msd_radix_sort(arr, n, shift - MSD_RADIX_BITS, key);
+    return;
+  }
+
+  // head[b] is the next slot to fill in bucket b, tail[b] its end.
+  std::array<std::size_t, BUCKETS> head, tail;
+  std::size_t offset = 0;
+  for (std::size_t b = 0; b < BUCKETS; b++) {
+    head[b] = offset;
+    offset += count[b];
+    tail[b] = offset;
+  }
+
+  // Move every element to its bucket by following permutation cycles: take the
+  // element at the head of bucket b, swap it into the head of its own bucket, and
+  // repeat until an element of bucket b comes back.
+  for (std::size_t b = 0; b < BUCKETS; b++) {
+    while (head[b] < tail[b]) {
+      T value = std::move(arr[head[b]]);
+      std::size_t dest = (key(value) >> shift) & MASK;
+      while (dest != b) {
+        std::swap(value, arr[head[dest]++]);
+        dest = (key(value) >> shift) & MASK;
+      }
+      arr[head[b]++] = std::move(value);
+    }
+  }
+
+  if (shift == 0) return;
+
+  std::size_t begin = 0;
+  for (std::size_t b = 0; b < BUCKETS; b++) {
+    if (count[b] > 1) msd_radix_sort(arr + begin, count[b], shift - MSD_RADIX_BITS, key);
+    begin += count[b];
+  }
+}
+
+// Sorts arr[0..n), whose elements are all in [min_key, max_key].
+template <typename T>
+void counting_sort(T* arr, std::size_t n, T min_key, T max_key) {
+  static_assert(std::is_integral_v<T>, "counting sort needs integer keys");
+  using U = std::make_unsigned_t<T>;
+  // Offsets from min_key, in unsigned arithmetic so that they cannot overflow.
+  U base = static_cast<U>(min_key);
+  std::size_t range = static_cast<U>(static_cast<U>(max_key) - base) + std::size_t(1);
+
+  std::vector<std::size_t> count(range, 0);
+  for (std::size_t i = 0; i < n; i++) count[static_cast<U>(static_cast<U>(arr[i]) - base)]++;
+
+  T* out = arr;
+  for (std::size_t v = 0; v < range; v++) {
+    out = std::fill_n(out, count[v], static_cast<T>(static_cast<U>(base + v)));
+  }
+}
+
+template <typename T>
+void radix_sort(std::vector<T>& arr) {
+  std::vector<T> tmp(arr.size());
+  lsd_radix_sort(arr.data(), tmp.data(), arr.size(), [](T x) { return to_radix_key(x); });
+}
+
+template <typename Key, typename Value>
+void radix_sort(std::vector<std::pair<Key, Value>>& arr) {
+  std::vector<std::pair<Key, Value>> tmp(arr.size());
+  lsd_radix_sort(arr.data(), tmp.data(), arr.size(),
+                 [](const std::pair<Key, Value>& p) { return to_radix_key(p.first); });
+}
+
+template <typename T>
+void msd_radix_sort(std::vector<T>& arr) {
+  constexpr int KEY_BITS = sizeof(radix_key_t<T>) * 8;
+  msd_radix_sort(arr.data(), arr.size(), KEY_BITS - MSD_RADIX_BITS,
+                 [](T x) { return to_radix_key(x); });
+}
+
+template <typename Key, typename Value>
+void msd_radix_sort(std::vector<std::pair<Key, Value>>& arr) {
+  constexpr int KEY_BITS = sizeof(radix_key_t<Key>) * 8;
+  msd_radix_sort(arr.data(), arr.size(), KEY_BITS - MSD_RADIX_BITS,
+                 [](const std::pair<Key, Value>& p) { return to_radix_key(p.first); });
+}
+
+#endif // end of radix_sort.h definition
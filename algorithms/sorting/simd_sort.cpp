@@ -0,0 +1,110 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_test_macros.hpp>
+
+#include "bits/stdc++.h"
+#include "simd_sort.h"
+#include "test_util.h"
+using namespace std;
+
+
+// Calls f(sort_small, partition) for every implementation this CPU can run.
+template <typename F>
+void for_each_simd_level(F f) {
+  f(scalar_sort_small, scalar_partition);
+#ifdef SIMD_SORT_X86
+  if (SIMD_LEVEL != SimdLevel::Scalar) f(sort_small_avx2, partition_avx2);
+  if (SIMD_LEVEL == SimdLevel::AVX512) f(sort_small_avx512, partition_avx512);
+#endif
+}
+
+TEST_CASE("sorting networks for every size up to SIMD_SORT_THRESHOLD") {
+  for_each_simd_level([](auto sort_small, auto) {
+    for (int n = 0; n <= SIMD_SORT_THRESHOLD; n++) {
+      for (int max_value : {INT_MIN + 3, 0, INT_MAX}) {
+        vector<int> arr = random_array(n, INT_MIN, max_value, n);
+        vector<int> expected = arr;
+        std::sort(expected.begin(), expected.end());
+
+        sort_small(arr.data(), n);
+        REQUIRE(arr == expected);
+      }
+    }
+  });
+}
+
+TEST_CASE("sorting networks with INT_MAX padding values in the input") {
+  for_each_simd_level([](auto sort_small, auto) {
+    vector<int> arr = {INT_MAX, 5, INT_MIN, INT_MAX, -1, 0, INT_MAX, 5, 9, INT_MIN, 2};
+    vector<int> expected = arr;
+    std::sort(expected.begin(), expected.end());
+
+    sort_small(arr.data(), arr.size());
+    REQUIRE(arr == expected);
+  });
+}
+
+TEST_CASE("vectorized partition") {
+  for_each_simd_level([](auto, auto partition_fn) {
+    for (int n : {0, 1, 15, 16, 17, 31, 32, 33, 100, 1000, 4097}) {
+      for (int max_value : {INT_MIN + 3, INT_MAX}) {
+        vector<int> arr = random_array(n, INT_MIN, max_value, n + 1);
+        vector<int> before = arr;
+        int pivot = n > 0 ? arr[n / 2] : 0;
+
+        // Partition a subrange, and check the rest is untouched.
+        int left = n / 4, right = n - n / 4;
+        int boundary = partition_fn(arr.data(), left, right, pivot);
+
+        REQUIRE(left <= boundary);
+        REQUIRE(boundary <= right);
+        for (int i = left; i < boundary; i++) REQUIRE(arr[i] < pivot);
+        for (int i = boundary; i < right; i++) REQUIRE(arr[i] >= pivot);
+        REQUIRE(is_permutation(arr.begin() + left, arr.begin() + right, before.begin() + left));
+        REQUIRE(equal(arr.begin(), arr.begin() + left, before.begin()));
+        REQUIRE(equal(arr.begin() + right, arr.end(), before.begin() + right));
+      }
+    }
+  });
+}
+
+TEST_CASE("vectorized find_greater") {
+  vector<size_t (*)(const int*, size_t, int)> kernels = {scalar_find_greater};
+#ifdef SIMD_SORT_X86
+  if (SIMD_LEVEL != SimdLevel::Scalar) kernels.push_back(find_greater_avx2);
+  if (SIMD_LEVEL == SimdLevel::AVX512) kernels.push_back(find_greater_avx512);
+#endif
+
+  for (auto find_greater : kernels) {
+    for (int n : {0, 1, 7, 8, 9, 31, 32, 33, 63, 64, 65, 1000}) {
+      vector<int> arr = random_array(n, INT_MIN, INT_MAX, n + 2);
+      for (int threshold : {INT_MIN, -1, INT_MAX - 1000, INT_MAX}) {
+        size_t expected = find_if(arr.begin(), arr.end(), [&](int x) { return x > threshold; }) -
+                          arr.begin();
+        REQUIRE(find_greater(arr.data(), n, threshold) == expected);
+      }
+
+      // A single element above the threshold at every position.
+      vector<int> zeros(n, 0);
+      for (int i = 0; i < n; i++) {
+        zeros[i] = 1;
+        REQUIRE(find_greater(zeros.data(), n, 0) == size_t(i));
+        zeros[i] = 0;
+      }
+    }
+  }
+}
+
+TEST_CASE("simd_sort_small and simd_partition dispatch") {
+  vector<int> arr = random_array(50, INT_MIN, INT_MAX, 7);
+  vector<int> expected = arr;
+  std::sort(expected.begin(), expected.end());
+  simd_sort_small(arr.data(), arr.size());
+  REQUIRE(arr == expected);
+
+  vector<int> values = random_array(1000, INT_MIN, 100, 8);
+  int boundary = simd_partition(values.data(), 0, values.size(), 0);
+  REQUIRE(all_of(values.begin(), values.begin() + boundary, [](int x) { return x < 0; }));
+  REQUIRE(all_of(values.begin() + boundary, values.end(), [](int x) { return x >= 0; }));
+
+  REQUIRE(simd_find_greater(values.data(), values.size(), 100) == values.size());
+}
@@ -0,0 +1,415 @@
+/* ====================================================================================
+   This file contains SIMD kernels for sorting ints, used by quick_sort.h and by the
+   partition() of partition.h (and so by quick_select):
+
+   - simd_sort_small(arr, n): sorts up to SIMD_SORT_THRESHOLD (64) ints with a
+     bitonic sorting network. The ints are padded with INT_MAX to 8, 16, 32 or 64
+     and kept in registers. Every compare-exchange step is a min, a max, a lane
+     permutation and a blend, with no branches on the data.
+
+   - simd_partition(arr, left, right, pivot): moves the ints < pivot in
+     arr[left..right) to the front and returns where the rest starts. It compares
+     a whole vector against the pivot at once, packs the lanes of each side
+     together (AVX2: a permutation from a 256-entry table indexed by the compare
+     mask; AVX-512: compress stores), and writes them to the left and right ends
+     of the range. The first vector from each end is held in registers, so there
+     is always room to write a vector to both ends, and the partition is in place.
+
+   - simd_find_greater(arr, n, threshold): the index of the first int > threshold
+     in arr[0..n). It compares four vectors per iteration and only looks at the
+     compare masks when one of them has a lane set, so scanning a run of rejected
+     elements (see StreamingTopK in streaming_select.h) costs a load and a compare
+     per vector.
+
+   Each kernel has an AVX2 and an AVX-512 version, compiled with
+   __attribute__((target)) so the rest of the program does not need -mavx2. The
+   version is picked at runtime from SIMD_LEVEL (__builtin_cpu_supports), and
+   other CPUs and compilers fall back to scalar code.
+=====================================================================================*/
+
+#ifndef SIMD_SORT_H
+#define SIMD_SORT_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <climits>
+#include <cstddef>
+#include <utility>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define SIMD_SORT_X86 1
+#include <immintrin.h>
+#endif
+
+enum class SimdLevel { Scalar, AVX2, AVX512 };
+
+inline SimdLevel detect_simd_level() {
+#ifdef SIMD_SORT_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) return SimdLevel::AVX512;
+  if (__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+#endif
+  return SimdLevel::Scalar;
+}
+
+inline const SimdLevel SIMD_LEVEL = detect_simd_level();
+
+const int SIMD_SORT_THRESHOLD = 64;
+
+inline void scalar_sort_small(int* arr, int n) {
+  for (int i = 1; i < n; i++) {
+    int key = arr[i];
+    int j = i - 1;
+    while (j >= 0 && key < arr[j]) {
+      arr[j + 1] = arr[j];
+      j--;
+    }
+    arr[j + 1] = key;
+  }
+}
+
+inline int scalar_partition(int* arr, int left, int right, int pivot) {
+  int boundary = left;
+  for (int i = left; i < right; i++) {
+    if (arr[i] < pivot) std::swap(arr[i], arr[boundary++]);
+  }
+  return boundary;
+}
+
+inline std::size_t scalar_find_greater(const int* arr, std::size_t n, int threshold) {
+  std::size_t i = 0;
+  while (i < n && arr[i] <= threshold) i++;
+  return i;
+}
+
+#ifdef SIMD_SORT_X86
+
+#define SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#define SIMD_TARGET_AVX512 __attribute__((target("avx512f")))
+
+// PARTITION_PERMUTATIONS[mask] moves the lanes whose bit is set in mask to the
+// front (in order) and the other lanes behind them.
+constexpr std::array<std::array<int, 8>, 256> make_partition_permutations() {
+  std::array<std::array<int, 8>, 256> table{};
+  for (int mask = 0; mask < 256; mask++) {
+    int k = 0;
+    for (int lane = 0; lane < 8; lane++) {
+      if (mask >> lane & 1) table[mask][k++] = lane;
+    }
+    for (int lane = 0; lane < 8; lane++) {
+      if (!(mask >> lane & 1)) table[mask][k++] = lane;
+    }
+  }
+  return table;
+}
+
+alignas(32) inline constexpr std::array<std::array<int, 8>, 256> PARTITION_PERMUTATIONS =
+    make_partition_permutations();
+
+// Sorts the 8 * n_vectors ints in r[] with a bitonic network. For every stage
+// (k, j), element g is compared with element g ^ j, and keeps the larger of the
+// two if exactly one of g & j and g & k is set.
+SIMD_TARGET_AVX2 inline void bitonic_sort_avx2(__m256i* r, int n_vectors) {
+  const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+  const __m256i ones = _mm256_set1_epi32(-1);
+  const __m256i zero = _mm256_setzero_si256();
+
+  for (int k = 2; k <= 8 * n_vectors; k *= 2) {
+    for (int j = k / 2; j > 0; j /= 2) {
+      if (j >= 8) {
+        // Compare whole vectors a and a ^ (j / 8).
+        for (int a = 0; a < n_vectors; a++) {
+          int b = a ^ (j / 8);
+          if (b < a) continue;
+          __m256i lo = _mm256_min_epi32(r[a], r[b]);
+          __m256i hi = _mm256_max_epi32(r[a], r[b]);
+          bool ascending = ((8 * a) & k) == 0;
+          r[a] = ascending ? lo : hi;
+          r[b] = ascending ? hi : lo;
+        }
+        continue;
+      }
+
+      __m256i jvec = _mm256_set1_epi32(j);
+      __m256i partner = _mm256_xor_si256(lanes, jvec);
+      __m256i upper = _mm256_cmpeq_epi32(_mm256_and_si256(lanes, jvec), jvec);
+      for (int a = 0; a < n_vectors; a++) {
+        __m256i descending;
+        if (k < 8) {
+          __m256i kvec = _mm256_set1_epi32(k);
+          descending = _mm256_cmpeq_epi32(_mm256_and_si256(lanes, kvec), kvec);
+        }
+        else {
+          descending = ((8 * a) & k) ? ones : zero;
+        }
+        __m256i take_max = _mm256_xor_si256(upper, descending);
+
+        __m256i other = _mm256_permutevar8x32_epi32(r[a], partner);
+        __m256i lo = _mm256_min_epi32(r[a], other);
+        __m256i hi = _mm256_max_epi32(r[a], other);
+        r[a] = _mm256_blendv_epi8(lo, hi, take_max);
+      }
+    }
+  }
+}
+
+SIMD_TARGET_AVX2 inline void sort_small_avx2(int* arr, int n) {
+  int n_vectors = n <= 8 ? 1 : n <= 16 ? 2 : n <= 32 ? 4 : 8;
+
+  alignas(32) int buffer[64];
+  std::copy(arr, arr + n, buffer);
+  std::fill(buffer + n, buffer + 8 * n_vectors, INT_MAX);
+
+  __m256i r[8];
+  for (int a = 0; a < n_vectors; a++) {
+    r[a] = _mm256_load_si256(reinterpret_cast<const __m256i*>(buffer + 8 * a));
+  }
+  bitonic_sort_avx2(r, n_vectors);
+  for (int a = 0; a < n_vectors; a++) {
+    _mm256_store_si256(reinterpret_cast<__m256i*>(buffer + 8 * a), r[a]);
+  }
+
+  std::copy(buffer, buffer + n, arr);
+}
+
+// Writes the lanes of v that are < pivot to arr[left..) and the others to
+// arr[..right), then moves left and right past them. Each side must have room for
+// a full vector.
+SIMD_TARGET_AVX2 inline void partition_vector_avx2(int* arr, __m256i v, __m256i pivot,
+                                                   int& left, int& right) {
+  int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(pivot, v)));
+  int n_less = std::popcount(static_cast<unsigned>(mask));
+
+  __m256i permutation = _mm256_load_si256(
+      reinterpret_cast<const __m256i*>(PARTITION_PERMUTATIONS[mask].data()));
+  v = _mm256_permutevar8x32_epi32(v, permutation);
+
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(arr + left), v);
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(arr + right - 8), v);
+  left += n_less;
+  right -= 8 - n_less;
+}
+
+SIMD_TARGET_AVX2 inline int partition_avx2(int* arr, int left, int right, int pivot) {
+  if (right - left < 16) return scalar_partition(arr, left, right, pivot);
+
+  __m256i pivot_vec = _mm256_set1_epi32(pivot);
+  __m256i first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(arr + left));
+  __m256i last = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(arr + right - 8));
+
+  // arr[left..read_left) and arr[read_right..right) have been read but not all
+  // written. Their sizes always add up to 16, and reading the next vector from the
+  // side with less room leaves at least 8 on both.
+  int read_left = left + 8, read_right = right - 8;
+  while (read_right - read_left >= 8) {
+    __m256i v;
+    if (read_left - left < right - read_right) {
+      v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(arr + read_left));
+      read_left += 8;
+    }
+    else {
+      read_right -= 8;
+      v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(arr + read_right));
+    }
+    partition_vector_avx2(arr, v, pivot_vec, left, right);
+  }
+
+  // Fewer than 8 unread elements remain; place them one by one.
+  int rest[8];
+  int n_rest = read_right - read_left;
+  std::copy(arr + read_left, arr + read_right, rest);
+  for (int i = 0; i < n_rest; i++) {
+    if (rest[i] < pivot) arr[left++] = rest[i];
+    else arr[--right] = rest[i];
+  }
+
+  partition_vector_avx2(arr, first, pivot_vec, left, right);
+  partition_vector_avx2(arr, last, pivot_vec, left, right);
+  return left;
+}
+
+SIMD_TARGET_AVX2 inline std::size_t find_greater_avx2(const int* arr, std::size_t n,
+                                                     int threshold) {
+  __m256i t = _mm256_set1_epi32(threshold);
+  const __m256i* v = reinterpret_cast<const __m256i*>(arr);
+
+  std::size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    __m256i a = _mm256_cmpgt_epi32(_mm256_loadu_si256(v + i / 8), t);
+    __m256i b = _mm256_cmpgt_epi32(_mm256_loadu_si256(v + i / 8 + 1), t);
+    __m256i c = _mm256_cmpgt_epi32(_mm256_loadu_si256(v + i / 8 + 2), t);
+    __m256i d = _mm256_cmpgt_epi32(_mm256_loadu_si256(v + i / 8 + 3), t);
+    __m256i any = _mm256_or_si256(_mm256_or_si256(a, b), _mm256_or_si256(c, d));
+    if (!_mm256_testz_si256(any, any)) break;
+  }
+  for (; i + 8 <= n; i += 8) {
+    __m256i gt = _mm256_cmpgt_epi32(_mm256_loadu_si256(v + i / 8), t);
+    int mask = _mm256_movemask_ps(_mm256_castsi256_ps(gt));
+    if (mask) return i + std::countr_zero(static_cast<unsigned>(mask));
+  }
+  return i + scalar_find_greater(arr + i, n - i, threshold);
+}
+
+// GCC 12 warns about the self-initialized _mm512_undefined_epi32() inside the
+// AVX-512 intrinsics as soon as they are inlined.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+SIMD_TARGET_AVX512 inline void bitonic_sort_avx512(__m512i* r, int n_vectors) {
+  const __m512i lanes = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+  // UPPER_LANES[log2(j)] has the bits of the lanes i with i & j set.
+  const __mmask16 UPPER_LANES[4] = {0xAAAA, 0xCCCC, 0xF0F0, 0xFF00};
+
+  for (int k = 2; k <= 16 * n_vectors; k *= 2) {
+    for (int j = k / 2; j > 0; j /= 2) {
+      if (j >= 16) {
+        for (int a = 0; a < n_vectors; a++) {
+          int b = a ^ (j / 16);
+          if (b < a) continue;
+          __m512i lo = _mm512_min_epi32(r[a], r[b]);
+          __m512i hi = _mm512_max_epi32(r[a], r[b]);
+          bool ascending = ((16 * a) & k) == 0;
+          r[a] = ascending ? lo : hi;
+          r[b] = ascending ? hi : lo;
+        }
+        continue;
+      }
+
+      __m512i partner = _mm512_xor_si512(lanes, _mm512_set1_epi32(j));
+      __mmask16 upper = UPPER_LANES[std::countr_zero(static_cast<unsigned>(j))];
+      for (int a = 0; a < n_vectors; a++) {
+        __mmask16 descending = k < 16 ? UPPER_LANES[std::countr_zero(static_cast<unsigned>(k))]
+                                      : (((16 * a) & k) ? 0xFFFF : 0);
+        __mmask16 take_max = upper ^ descending;
+
+        __m512i other = _mm512_permutexvar_epi32(partner, r[a]);
+        __m512i lo = _mm512_min_epi32(r[a], other);
+        __m512i hi = _mm512_max_epi32(r[a], other);
+        r[a] = _mm512_mask_blend_epi32(take_max, lo, hi);
+      }
+    }
+  }
+}
+
+SIMD_TARGET_AVX512 inline void sort_small_avx512(int* arr, int n) {
+  int n_vectors = n <= 16 ? 1 : n <= 32 ? 2 : 4;
+
+  alignas(64) int buffer[64];
+  std::copy(arr, arr + n, buffer);
+  std::fill(buffer + n, buffer + 16 * n_vectors, INT_MAX);
+
+  __m512i r[4];
+  for (int a = 0; a < n_vectors; a++) r[a] = _mm512_load_si512(buffer + 16 * a);
+  bitonic_sort_avx512(r, n_vectors);
+  for (int a = 0; a < n_vectors; a++) _mm512_store_si512(buffer + 16 * a, r[a]);
+
+  std::copy(buffer, buffer + n, arr);
+}
+
+SIMD_TARGET_AVX512 inline void partition_vector_avx512(int* arr, __m512i v, __m512i pivot,
+                                                       int& left, int& right) {
+  __mmask16 less = _mm512_cmplt_epi32_mask(v, pivot);
+  int n_less = std::popcount(static_cast<unsigned>(less));
+
+  _mm512_mask_compressstoreu_epi32(arr + left, less, v);
+  _mm512_mask_compressstoreu_epi32(arr + right - (16 - n_less), static_cast<__mmask16>(~less), v);
+  left += n_less;
+  right -= 16 - n_less;
+}
+
+SIMD_TARGET_AVX512 inline int partition_avx512(int* arr, int left, int right, int pivot) {
+  if (right - left < 32) return partition_avx2(arr, left, right, pivot);
+
+  __m512i pivot_vec = _mm512_set1_epi32(pivot);
+  __m512i first = _mm512_loadu_si512(arr + left);
+  __m512i last = _mm512_loadu_si512(arr + right - 16);
+
+  // Same scheme as partition_avx2, with 16 lanes.
+  int read_left = left + 16, read_right = right - 16;
+  while (read_right - read_left >= 16) {
+    __m512i v;
+    if (read_left - left < right - read_right) {
+      v = _mm512_loadu_si512(arr + read_left);
+      read_left += 16;
+    }
+    else {
+      read_right -= 16;
+      v = _mm512_loadu_si512(arr + read_right);
+    }
+    partition_vector_avx512(arr, v, pivot_vec, left, right);
+  }
+
+  int rest[16];
+  int n_rest = read_right - read_left;
+  std::copy(arr + read_left, arr + read_right, rest);
+  for (int i = 0; i < n_rest; i++) {
+    if (rest[i] < pivot) arr[left++] = rest[i];
+    else arr[--right] = rest[i];
+  }
+
+  partition_vector_avx512(arr, first, pivot_vec, left, right);
+  partition_vector_avx512(arr, last, pivot_vec, left, right);
+  return left;
+}
+
+SIMD_TARGET_AVX512 inline std::size_t find_greater_avx512(const int* arr, std::size_t n,
+                                                         int threshold) {
+  __m512i t = _mm512_set1_epi32(threshold);
+  std::size_t i = 0;
+  for (; i + 64 <= n; i += 64) {
+    __mmask16 a = _mm512_cmpgt_epi32_mask(_mm512_loadu_si512(arr + i), t);
+    __mmask16 b = _mm512_cmpgt_epi32_mask(_mm512_loadu_si512(arr + i + 16), t);
+    __mmask16 c = _mm512_cmpgt_epi32_mask(_mm512_loadu_si512(arr + i + 32), t);
+    __mmask16 d = _mm512_cmpgt_epi32_mask(_mm512_loadu_si512(arr + i + 48), t);
+    if (a | b | c | d) break;
+  }
+  for (; i + 16 <= n; i += 16) {
+    __mmask16 mask = _mm512_cmpgt_epi32_mask(_mm512_loadu_si512(arr + i), t);
+    if (mask) return i + std::countr_zero(static_cast<unsigned>(mask));
+  }
+  return i + scalar_find_greater(arr + i, n - i, threshold);
+}
+
+#pragma GCC diagnostic pop
+
+#endif // SIMD_SORT_X86
+
+/**
+ * @brief Sort arr[0..n) with a sorting network.
+ * @param n At most SIMD_SORT_THRESHOLD.
+ */
+inline void simd_sort_small(int* arr, int n) {
+#ifdef SIMD_SORT_X86
+  if (SIMD_LEVEL == SimdLevel::AVX512) return sort_small_avx512(arr, n);
+  if (SIMD_LEVEL == SimdLevel::AVX2) return sort_small_avx2(arr, n);
+#endif
+  scalar_sort_small(arr, n);
+}
+
+/**
+ * @brief Move the elements < pivot of arr[left..right) to the front.
+ * @return The index of the first element >= pivot after the call.
+ */
+inline int simd_partition(int* arr, int left, int right, int pivot) {
+#ifdef SIMD_SORT_X86
+  if (SIMD_LEVEL == SimdLevel::AVX512) return partition_avx512(arr, left, right, pivot);
+  if (SIMD_LEVEL == SimdLevel::AVX2) return partition_avx2(arr, left, right, pivot);
+#endif
+  return scalar_partition(arr, left, right, pivot);
+}
+
+/**
+ * @brief Find the first element of arr[0..n) greater than threshold.
+ * @return Its index, or n if there is none.
+ */
+inline std::size_t simd_find_greater(const int* arr, std::size_t n, int threshold) {
+#ifdef SIMD_SORT_X86
+  if (SIMD_LEVEL == SimdLevel::AVX512) return find_greater_avx512(arr, n, threshold);
+  if (SIMD_LEVEL == SimdLevel::AVX2) return find_greater_avx2(arr, n, threshold);
+#endif
+  return scalar_find_greater(arr, n, threshold);
+}
+
+#endif // end of simd_sort.h definition
@@ -0,0 +1,277 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_test_macros.hpp>
+
+#include "bits/stdc++.h"
+#include "sort.h"
+#include "test_util.h"
+using namespace std;
+
+
+struct Record {
+  int id;
+  double score;
+  string name;
+};
+
+// Counts its calls, to tell the comparison sorts from the radix sort.
+struct CountingLess {
+  int* calls;
+  bool operator()(double a, double b) const {
+    (*calls)++;
+    return a < b;
+  }
+};
+
+static_assert(sort_path<vector<int>::iterator, ranges::less, identity>() == SortPath::SimdIntrosort);
+static_assert(sort_path<double*, less<>, identity>() == SortPath::Radix);
+static_assert(sort_path<vector<Record>::iterator, ranges::less, int Record::*>() == SortPath::Radix);
+static_assert(sort_path<vector<int>::iterator, greater<>, identity>() == SortPath::Introsort);
+static_assert(sort_path<deque<int>::iterator, ranges::less, identity>() == SortPath::Introsort);
+static_assert(sort_path<vector<string>::iterator, ranges::less, identity>() == SortPath::Introsort);
+static_assert(sort_path<vector<bool>::iterator, ranges::less, identity>() == SortPath::Introsort);
+
+TEST_CASE("sort function on containers and views") {
+  for (int n : {0, 1, 2, 17, 1000, 100000}) {
+    vector<int> arr = random_array(n, -n, n, n);
+    vector<int> expected = arr;
+    std::sort(expected.begin(), expected.end());
+
+    vector<int> v = arr;
+    sort(v.begin(), v.end());
+    REQUIRE(v == expected);
+
+    deque<int> d(arr.begin(), arr.end());
+    sort(d);
+    REQUIRE(equal(d.begin(), d.end(), expected.begin(), expected.end()));
+
+    vector<int> buffer = arr;
+    sort(span<int>(buffer));
+    REQUIRE(buffer == expected);
+
+    vector<int> descending = arr;
+    sort(descending, greater<>());
+    REQUIRE(equal(descending.rbegin(), descending.rend(), expected.begin(), expected.end()));
+  }
+
+  array<int, 5> small = {5, 3, 4, 1, 2};
+  sort(small);
+  REQUIRE(small == array<int, 5>{1, 2, 3, 4, 5});
+
+  int raw[] = {3, -1, 2};
+  sort(raw, raw + 3);
+  REQUIRE(vector<int>(raw, raw + 3) == vector<int>{-1, 2, 3});
+}
+
+TEST_CASE("sort function with arithmetic keys") {
+  mt19937 rng(3);
+  uniform_real_distribution<double> dist(-1e6, 1e6);
+  vector<double> values(5000);
+  for (double& x : values) x = dist(rng);
+  values[10] = -0.0;
+  values[20] = 0.0;
+  vector<double> expected = values;
+  std::sort(expected.begin(), expected.end());
+
+  vector<double> radix = values;
+  sort(radix);
+  REQUIRE(radix == expected);
+
+  int calls = 0;
+  vector<double> counted = values;
+  sort(counted, CountingLess{&calls});
+  REQUIRE(counted == expected);
+  REQUIRE(calls > 0);
+
+  vector<long long> wide = {5000000000LL, -3, 7, LLONG_MIN, LLONG_MAX, 0};
+  sort(wide);
+  REQUIRE(wide == vector<long long>{LLONG_MIN, -3, 0, 7, 5000000000LL, LLONG_MAX});
+
+  vector<unsigned char> bytes(3000);
+  for (size_t i = 0; i < bytes.size(); i++) bytes[i] = (i * 37) % 256;
+  sort(bytes);
+  REQUIRE(is_sorted(bytes.begin(), bytes.end()));
+}
+
+TEST_CASE("sort function with projections") {
+  vector<Record> records;
+  for (int i = 0; i < 3000; i++) {
+    records.push_back({(i * 7919) % 3000, (i % 10) * 0.5, "r" + to_string(i)});
+  }
+
+  sort(records, ranges::less(), &Record::id);
+  for (int i = 0; i < 3000; i++) REQUIRE(records[i].id == i);
+  REQUIRE(records[0].name == "r0");
+
+  sort(records.begin(), records.end(), greater<>(), &Record::score);
+  REQUIRE(is_sorted(records.begin(), records.end(),
+                    [](const Record& a, const Record& b) { return a.score > b.score; }));
+
+  quick_sort(records, {}, &Record::name);
+  REQUIRE(is_sorted(records.begin(), records.end(),
+                    [](const Record& a, const Record& b) { return a.name < b.name; }));
+
+  vector<string> words = {"pear", "fig", "banana", "apple", "kiwi"};
+  sort(words, ranges::less(), [](const string& w) { return w.size(); });
+  REQUIRE(words.front() == "fig");
+  REQUIRE(words.back() == "banana");
+}
+
+TEST_CASE("quick_sort function on adversarial input") {
+  int n = 100000;
+  vector<vector<int>> inputs = {random_array(n, -5, 5, 1), vector<int>(n, 3), sorted_array(n),
+                                organ_pipe_array(n)};
+
+  for (const vector<int>& input : inputs) {
+    vector<int> expected = input;
+    std::sort(expected.begin(), expected.end());
+
+    deque<int> d(input.begin(), input.end());
+    quick_sort(d);
+    REQUIRE(equal(d.begin(), d.end(), expected.begin(), expected.end()));
+  }
+}
+
+TEST_CASE("quick_select function with iterators") {
+  for (int n : {1, 10, 1000, 100000}) {
+    vector<int> arr = random_array(n, -(n / 4), n / 4, n);
+    vector<int> expected = arr;
+    std::sort(expected.begin(), expected.end());
+
+    for (int k : {0, n / 3, n - 1}) {
+      vector<int> v = arr;
+      REQUIRE(*quick_select(v, v.begin() + k) == expected[k]);
+      REQUIRE(*max_element(v.begin(), v.begin() + k + 1) == v[k]);
+
+      deque<int> d(arr.begin(), arr.end());
+      quick_select(d.begin(), d.begin() + k, d.end());
+      REQUIRE(d[k] == expected[k]);
+      REQUIRE(*max_element(d.begin(), d.begin() + k + 1) == d[k]);
+      REQUIRE(*min_element(d.begin() + k, d.end()) == d[k]);
+    }
+  }
+
+  vector<Record> records = {{3, 1.5, "c"}, {1, 0.5, "a"}, {2, 2.5, "b"}};
+  REQUIRE(quick_select(records, records.begin() + 1, greater<>(), &Record::score)->name == "c");
+}
+
+// A record too wide to move through the radix passes.
+struct WideRecord {
+  int key;
+  char payload[124];
+};
+
+TEST_CASE("choose_sort function and sort dispatch") {
+  int n = 100000;
+  vector<int> sorted_input = sorted_array(n);
+
+  // Checks that sort() picks algorithm, as choose_sort() predicts, and sorts.
+  auto check = [](auto arr, SortAlgorithm algorithm) {
+    auto expected = arr;
+    std::sort(expected.begin(), expected.end());
+    REQUIRE(choose_sort(arr.begin(), arr.end()).algorithm == algorithm);
+    SortDecision d = sort(arr.begin(), arr.end());
+    REQUIRE(d.algorithm == algorithm);
+    REQUIRE(arr == expected);
+    return d;
+  };
+
+  SECTION("shapes of int input") {
+    SortDecision d = check(random_array(n, -(1 << 30), 1 << 30, 1), SortAlgorithm::SimdIntrosort);
+    REQUIRE(d.sampled);
+    REQUIRE(d.local_disorder > d.window_pairs / 4);
+    REQUIRE(d.sample_distinct == 0);
+
+    check(random_array(10, -100, 100, 2), SortAlgorithm::Insertion);
+    check(random_array(1000, -(1 << 30), 1 << 30, 3), SortAlgorithm::SimdIntrosort);
+
+    // Nearly sorted, reversed and sorted with a random tail go to the merge sort.
+    vector<int> nearly = sorted_input;
+    mt19937 rng(4);
+    for (int i = 0; i < 20; i++) swap(nearly[rng() % n], nearly[rng() % n]);
+    check(nearly, SortAlgorithm::AdaptiveMerge);
+    check(vector<int>(sorted_input.rbegin(), sorted_input.rend()), SortAlgorithm::AdaptiveMerge);
+    vector<int> appended = sorted_input;
+    for (int i = n - n / 200; i < n; i++) appended[i] = rng() % n;
+    check(appended, SortAlgorithm::AdaptiveMerge);
+
+    // Sorted blocks of 1000 in random order are too short for the int path.
+    vector<int> blocks = random_array(n, -(1 << 30), 1 << 30, 5);
+    for (int i = 0; i < n; i += 1000) std::sort(blocks.begin() + i, blocks.begin() + i + 1000);
+    check(blocks, SortAlgorithm::SimdIntrosort);
+  }
+
+  SECTION("small value ranges") {
+    SortDecision d = check(random_array(n, -1000, 1000, 6), SortAlgorithm::Counting);
+    REQUIRE(d.key_range_exact);
+    REQUIRE(d.max_key - d.min_key <= 2000);
+
+    vector<long long> wide(n);
+    for (int i = 0; i < n; i++) wide[i] = LLONG_MIN + (i * 7919) % 5000;
+    check(wide, SortAlgorithm::Counting);
+
+    vector<unsigned char> bytes(n);
+    for (int i = 0; i < n; i++) bytes[i] = (i * 37) % 256;
+    check(bytes, SortAlgorithm::Counting);
+
+    // One outlier the sample misses makes the range too wide after the exact pass.
+    vector<int> outlier = random_array(n, -1000, 1000, 7);
+    outlier[n / 2 + 1] = INT_MAX;
+    d = check(outlier, SortAlgorithm::SimdIntrosort);
+    REQUIRE(d.key_range_exact);
+  }
+
+  SECTION("other key types") {
+    mt19937 rng(8);
+    vector<double> values(n);
+    for (double& x : values) x = rng() / 7.0 - 1e8;
+    check(values, SortAlgorithm::Radix);
+
+    vector<string> words(n);
+    for (string& w : words) w = to_string(rng());
+    check(words, SortAlgorithm::Introsort);
+
+    SortDecision distinct = check(words, SortAlgorithm::Introsort);
+    REQUIRE(distinct.sample_distinct > distinct.sample_size / 2);
+
+    // Few distinct strings, or ints in an order the int path does not handle, go
+    // to the three-way quicksort.
+    vector<string> few(n);
+    for (string& w : few) w = "key" + to_string(rng() % 20);
+    REQUIRE(check(few, SortAlgorithm::ThreeWay).sample_distinct <= 20);
+    vector<int> descending = random_array(n, -5, 5, 10);
+    REQUIRE(sort(descending, greater<>()).algorithm == SortAlgorithm::ThreeWay);
+    REQUIRE(is_sorted(descending.begin(), descending.end(), greater<>()));
+
+    // Strings in runs of 1000 are long enough for a comparison sort to merge.
+    for (int i = 0; i < n; i += 1000) std::sort(words.begin() + i, words.begin() + i + 1000);
+    check(words, SortAlgorithm::AdaptiveMerge);
+
+    vector<WideRecord> records(n);
+    for (int i = 0; i < n; i++) records[i].key = rng() % n;
+    REQUIRE(sort(records, ranges::less(), &WideRecord::key).algorithm == SortAlgorithm::KeyIndex);
+    REQUIRE(is_sorted(records.begin(), records.end(),
+                      [](const auto& a, const auto& b) { return a.key < b.key; }));
+
+    deque<int> d(n);
+    for (int& x : d) x = rng();
+    REQUIRE(sort(d).algorithm == SortAlgorithm::Introsort);
+    REQUIRE(is_sorted(d.begin(), d.end()));
+  }
+
+  SECTION("sort(vector<int>&) goes through the dispatcher") {
+    vector<int> nearly = sorted_input;
+    nearly[n / 2] = -1;
+    vector<int> expected = nearly;
+    std::sort(expected.begin(), expected.end());
+    REQUIRE(sort(nearly).algorithm == SortAlgorithm::AdaptiveMerge);
+    REQUIRE(nearly == expected);
+  }
+
+  SECTION("large int arrays") {
+    SortAlgorithm expected = thread::hardware_concurrency() > 1 ? SortAlgorithm::Parallel
+                                                                : SortAlgorithm::SimdIntrosort;
+    check(random_array(1 << 20, -(1 << 30), 1 << 30, 9), expected);
+    REQUIRE(string(sort_algorithm_name(expected)) ==
+            (expected == SortAlgorithm::Parallel ? "parallel" : "simd_introsort"));
+  }
+}
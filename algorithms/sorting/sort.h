@@ -0,0 +1,634 @@
+/* ====================================================================================
+   This file contains the generic front end of the sorting module: sort(),
+   quick_sort() and quick_select() over any random access iterator range (vectors,
+   arrays, spans, deques, buffers given as pointers), with a comparator and a
+   projection, like the std::ranges algorithms:
+
+     sort(records, std::ranges::less(), &Record::id);   // by id, ascending
+     sort(names.begin(), names.end(), std::greater<>());
+     quick_select(scores, scores.begin() + k);          // nth_element
+
+   sort() picks the algorithm in two steps.
+
+   At compile time, from the iterator, the comparator and the type of the projected
+   key (see sort_path()):
+     - SortPath::SimdIntrosort: contiguous ints with the default ordering go to the
+       int introsort of quick_sort.h (branchless block partition, SIMD networks).
+     - SortPath::Radix: other arithmetic keys (after projection) with the default
+       ordering, in contiguous memory, go to the LSD radix sort of radix_sort.h once
+       there are at least GENERIC_RADIX_THRESHOLD elements. The records move with
+       their keys, so sorting structs by a numeric field needs no copy to a
+       vector<int> and back. Records of KEY_INDEX_MIN_BYTES or more are sorted
+       indirectly instead (key_index_sort() of indirect_sort.h): their (key, index)
+       pairs are radix sorted and every record moves once.
+     - SortPath::Introsort: everything else. Median of three or ninther pivots,
+       Hoare partition (stops on equal keys, so duplicates split evenly), heap sort
+       after 2 * log2(n) levels, insertion sort for small ranges.
+
+   At run time, choose_sort() samples ranges of DISPATCH_SAMPLE_THRESHOLD elements
+   or more, at a cost of a few thousand comparisons (about 6 us, 3% of sorting
+   DISPATCH_SAMPLE_THRESHOLD random ints):
+     - Presortedness: the adjacent pairs in DISPATCH_WINDOWS windows of
+       DISPATCH_WINDOW_SIZE consecutive elements spread over the range, counting
+       the pairs that go against their window's direction (local disorder), and the
+       consecutive elements of a stratified random sample of DISPATCH_SAMPLE_SIZE
+       positions, in position order (global disorder).
+     - Duplicates: the number of distinct keys in that random sample, for the
+       generic introsort path only (the int and radix paths are not slowed down
+       by duplicates, so they skip the sort of the sample this takes).
+     - Value range: the smallest and the largest key of the sample (radix keys).
+   and overrides the static choice when the input has a shape it can exploit:
+     - SortAlgorithm::AdaptiveMerge (merge_sort.h) when the input is made of long
+       runs. A comparison sort already pays log2(n) comparisons per element, so one
+       disordered pair in DISPATCH_COMPARISON_DISORDER (runs of that length) is
+       enough. The int and radix paths are several times faster per level than the
+       merge, so they give way only to input that is almost sorted (or reversed)
+       both locally and globally, where galloping makes the merge close to O(n).
+     - SortAlgorithm::Counting (counting_sort() of radix_sort.h) for integers whose
+       range, checked exactly with one more pass, is at most n / COUNTING_SORT_DENSITY.
+     - SortAlgorithm::ThreeWay for comparison-only keys when at most one sampled key
+       in DISPATCH_FEW_DISTINCT is distinct: a quicksort with a three-way (Dijkstra)
+       partition, which takes every key equal to the pivot out of the recursion, so
+       d distinct keys cost O(n log d) comparisons instead of O(n log n).
+     - SortAlgorithm::Parallel (parallel_sort.h) for at least
+       PARALLEL_DISPATCH_THRESHOLD ints when the machine has more than one core.
+   Ranges of at most INSERTION_SORT_THRESHOLD elements are insertion sorted.
+
+   sort() returns the SortDecision it executed, with the sampled statistics, so
+   call sites can log or audit what it did; choose_sort() computes the same
+   decision without sorting.
+
+   The default ordering is std::ranges::less, std::less<> or std::less<Key>. Like
+   std::sort, sort() is not guaranteed to be stable (some of its paths are); use
+   merge_sort() or key_index_sort() when the order of equal keys matters.
+
+   Argument dependent lookup also finds std::sort for standard containers and
+   iterators. sort(first, last) and sort(first, last, comp) are declared so that
+   they win over it, but when passing a projection, spell out the comparator:
+   sort(v, {}, proj) would deduce std::sort(first, last, comp) and fail to compile.
+
+   @param first, last: the range to sort
+   @param comp:        the ordering of the projected keys
+   @param proj:        the key of an element, std::identity by default
+=====================================================================================*/
+
+#ifndef SORT_H
+#define SORT_H
+
+#include <algorithm>
+#include <bit>
+#include <climits>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "heap.h"
+#include "indirect_sort.h"
+#include "merge_sort.h"
+#include "parallel_sort.h"
+#include "quick_select.h"
+#include "quick_sort.h"
+#include "radix_sort.h"
+#include "sort_traits.h"
+
+const std::size_t KEY_INDEX_MIN_BYTES = 64;
+const std::size_t DISPATCH_SAMPLE_THRESHOLD = 1 << 14;
+const std::size_t DISPATCH_WINDOWS = 32;
+const std::size_t DISPATCH_WINDOW_SIZE = 64;
+const std::size_t DISPATCH_SAMPLE_SIZE = 256;
+const std::size_t DISPATCH_COMPARISON_DISORDER = 64;
+const std::size_t DISPATCH_LOCAL_DISORDER = 32;
+const std::size_t DISPATCH_GLOBAL_DISORDER = 32;
+const std::size_t DISPATCH_FEW_DISTINCT = 8;
+const std::size_t COUNTING_SORT_DENSITY = 2;
+const std::size_t PARALLEL_DISPATCH_THRESHOLD = 1 << 20;
+
+enum class SortPath { Introsort, SimdIntrosort, Radix };
+
+/**
+ * @brief The algorithm sort() uses for these iterator, comparator and projection types.
+ */
+template <typename I, typename Comp, typename Proj>
+constexpr SortPath sort_path() {
+  using Value = std::iter_value_t<I>;
+  using Key = std::remove_cvref_t<std::indirect_result_t<Proj&, I>>;
+
+  if constexpr (!std::contiguous_iterator<I> || !is_default_order_v<Comp, Key>) {
+    return SortPath::Introsort;
+  }
+  else if constexpr (std::is_same_v<Value, int> && std::is_same_v<Proj, std::identity>) {
+    return SortPath::SimdIntrosort;
+  }
+  else if constexpr (is_radix_key_v<Key> && std::is_default_constructible_v<Value> &&
+                     std::is_move_assignable_v<Value>) {
+    return SortPath::Radix;
+  }
+  else {
+    return SortPath::Introsort;
+  }
+}
+
+template <typename I, typename Less>
+void generic_insertion_sort(I first, I last, Less& less) {
+  if (first == last) return;
+  for (I i = first + 1; i != last; ++i) {
+    std::iter_value_t<I> key = std::move(*i);
+    I j = i;
+    while (j != first && less(key, *(j - 1))) {
+      *j = std::move(*(j - 1));
+      --j;
+    }
+    *j = std::move(key);
+  }
+}
+
+template <typename I, typename Less>
+void generic_sort3(I a, I b, I c, Less& less) {
+  if (less(*b, *a)) std::iter_swap(a, b);
+  if (less(*c, *b)) std::iter_swap(b, c);
+  if (less(*b, *a)) std::iter_swap(a, b);
+}
+
+// Moves the pivot (median of three or ninther) to *first, like choose_pivot().
+template <typename I, typename Less>
+void generic_choose_pivot(I first, I last, Less& less) {
+  auto n = last - first;
+  I mid = first + n / 2;
+  if (n > NINTHER_THRESHOLD) {
+    generic_sort3(first, mid, last - 1, less);
+    generic_sort3(first + 1, mid - 1, last - 2, less);
+    generic_sort3(first + 2, mid + 1, last - 3, less);
+    generic_sort3(mid - 1, mid, mid + 1, less);
+    std::iter_swap(first, mid);
+  }
+  else {
+    generic_sort3(mid, first, last - 1, less);
+  }
+}
+
+// Hoare partition of [first, last) around *first. Returns the pivot's final
+// position: everything before it is <= pivot, everything after it >= pivot. Both
+// scans stop on keys equal to the pivot, so runs of equal keys split evenly. They
+// need no bounds checks: generic_choose_pivot() leaves an element >= pivot after
+// it, the pivot itself stops the right scan, and every swap leaves a stopper for
+// the next round.
+template <typename I, typename Less>
+I generic_partition(I first, I last, Less& less) {
+  I lo = first, hi = last;
+  while (true) {
+    while (less(*++lo, *first)) {}
+    while (less(*first, *--hi)) {}
+    if (lo >= hi) break;
+    std::iter_swap(lo, hi);
+  }
+  std::iter_swap(first, hi);
+  return hi;
+}
+
+template <typename I, typename Less>
+void generic_introsort_loop(I first, I last, int depth_limit, Less& less) {
+  while (last - first > INSERTION_SORT_THRESHOLD) {
+    if (depth_limit-- == 0) {
+      heap_sort<4>(first, last - first, less);
+      return;
+    }
+
+    generic_choose_pivot(first, last, less);
+    I pivot = generic_partition(first, last, less);
+
+    // Recurse into the smaller side, loop on the larger one.
+    if (pivot - first < last - pivot) {
+      generic_introsort_loop(first, pivot, depth_limit, less);
+      first = pivot + 1;
+    }
+    else {
+      generic_introsort_loop(pivot + 1, last, depth_limit, less);
+      last = pivot;
+    }
+  }
+  generic_insertion_sort(first, last, less);
+}
+
+// Like generic_introsort_loop(), with a three-way partition: [first, lt) < pivot,
+// [lt, gt) == pivot, [gt, last) > pivot. The keys equal to the pivot are done, so
+// each distinct key is a pivot at most once. *lt is always equal to the pivot and
+// serves as the pivot, which therefore never needs to be copied.
+template <typename I, typename Less>
+void generic_three_way_loop(I first, I last, int depth_limit, Less& less) {
+  while (last - first > INSERTION_SORT_THRESHOLD) {
+    if (depth_limit-- == 0) {
+      heap_sort<4>(first, last - first, less);
+      return;
+    }
+
+    generic_choose_pivot(first, last, less);
+    I lt = first, i = first + 1, gt = last;
+    while (i < gt) {
+      if (less(*i, *lt)) std::iter_swap(lt++, i++);
+      else if (less(*lt, *i)) std::iter_swap(i, --gt);
+      else ++i;
+    }
+
+    if (lt - first < last - gt) {
+      generic_three_way_loop(first, lt, depth_limit, less);
+      first = gt;
+    }
+    else {
+      generic_three_way_loop(gt, last, depth_limit, less);
+      last = lt;
+    }
+  }
+  generic_insertion_sort(first, last, less);
+}
+
+template <typename I, typename Less>
+void generic_introselect(I first, I nth, I last, Less& less) {
+  int depth_limit = 2 * std::bit_width(static_cast<std::size_t>(last - first));
+  while (last - first > INSERTION_SORT_THRESHOLD) {
+    if (depth_limit-- == 0) {
+      heap_sort<4>(first, last - first, less);
+      return;
+    }
+
+    generic_choose_pivot(first, last, less);
+    I pivot = generic_partition(first, last, less);
+    if (pivot == nth) return;
+    if (nth < pivot) last = pivot;
+    else first = pivot + 1;
+  }
+  generic_insertion_sort(first, last, less);
+}
+
+/**
+ * @brief Sort [first, last) with the generic introsort, whatever the key type.
+ */
+template <typename I, typename S, typename Comp = std::ranges::less,
+          typename Proj = std::identity>
+  requires std::random_access_iterator<I> && std::sentinel_for<S, I> &&
+           std::sortable<I, Comp, Proj>
+void quick_sort(I first, S last, Comp comp = {}, Proj proj = {}) {
+  I end = std::ranges::next(first, last);
+  auto less = projected_less(comp, proj);
+  int depth_limit = 2 * std::bit_width(static_cast<std::size_t>(end - first));
+  generic_introsort_loop(first, end, depth_limit, less);
+}
+
+template <typename R, typename Comp = std::ranges::less, typename Proj = std::identity>
+  requires std::ranges::random_access_range<R> &&
+           std::sortable<std::ranges::iterator_t<R>, Comp, Proj>
+void quick_sort(R&& range, Comp comp = {}, Proj proj = {}) {
+  quick_sort(std::ranges::begin(range), std::ranges::end(range), std::move(comp), std::move(proj));
+}
+
+enum class SortAlgorithm {
+  Insertion,
+  Introsort,
+  SimdIntrosort,
+  Radix,
+  KeyIndex,
+  Counting,
+  AdaptiveMerge,
+  Parallel,
+  ThreeWay
+};
+
+inline const char* sort_algorithm_name(SortAlgorithm algorithm) {
+  switch (algorithm) {
+    case SortAlgorithm::Insertion: return "insertion";
+    case SortAlgorithm::Introsort: return "introsort";
+    case SortAlgorithm::SimdIntrosort: return "simd_introsort";
+    case SortAlgorithm::Radix: return "radix";
+    case SortAlgorithm::KeyIndex: return "key_index";
+    case SortAlgorithm::Counting: return "counting";
+    case SortAlgorithm::AdaptiveMerge: return "adaptive_merge";
+    case SortAlgorithm::Parallel: return "parallel";
+    case SortAlgorithm::ThreeWay: return "three_way";
+  }
+  return "unknown";
+}
+
+// The algorithm choose_sort() picked, and the statistics it picked it from. The
+// statistics are left at zero when the range was too small to sample.
+struct SortDecision {
+  SortAlgorithm algorithm = SortAlgorithm::Introsort;
+  std::size_t n = 0;
+  bool sampled = false;
+
+  // Adjacent pairs compared in the windows, and how many of them go against the
+  // direction of their window.
+  std::size_t window_pairs = 0;
+  std::size_t local_disorder = 0;
+
+  // Random positions sampled; how many consecutive ones (in position order) go
+  // against the sample's direction; how many distinct keys they hold (generic
+  // introsort path only, zero otherwise).
+  std::size_t sample_size = 0;
+  std::size_t global_disorder = 0;
+  std::size_t sample_distinct = 0;
+
+  // Radix keys only: the smallest and the largest to_radix_key() of the sample, or
+  // of the whole range if key_range_exact.
+  bool has_key_range = false;
+  bool key_range_exact = false;
+  std::uint64_t min_key = 0, max_key = 0;
+};
+
+// Integers in contiguous memory, sorted by value in the default order, which
+// counting_sort() can handle.
+template <typename I, typename Comp, typename Proj>
+constexpr bool is_countable_v = sort_path<I, Comp, Proj>() != SortPath::Introsort &&
+                                std::is_integral_v<std::iter_value_t<I>> &&
+                                std::is_same_v<Proj, std::identity>;
+
+// Counts the adjacent pairs in each window that go against the window's direction.
+template <typename I, typename Less>
+void sample_local_disorder(I first, SortDecision& d, Less& less) {
+  for (std::size_t w = 0; w < DISPATCH_WINDOWS; w++) {
+    I window = first + (d.n - DISPATCH_WINDOW_SIZE) * w / (DISPATCH_WINDOWS - 1);
+    std::size_t up = 0, down = 0;
+    for (std::size_t i = 1; i < DISPATCH_WINDOW_SIZE; i++) {
+      if (less(window[i], window[i - 1])) down++;
+      else if (less(window[i - 1], window[i])) up++;
+    }
+    d.window_pairs += DISPATCH_WINDOW_SIZE - 1;
+    d.local_disorder += std::min(up, down);
+  }
+}
+
+// Samples random positions for the global disorder, the key range and, if
+// count_distinct, the distinct keys.
+template <typename I, typename Less, typename Proj>
+void sample_positions(I first, SortDecision& d, Less& less, Proj& proj, bool count_distinct) {
+  // One random position in each of DISPATCH_SAMPLE_SIZE equal strata, so the
+  // positions are distinct and already in order.
+  std::vector<std::size_t> pos(DISPATCH_SAMPLE_SIZE);
+  std::size_t stratum = d.n / DISPATCH_SAMPLE_SIZE;
+  uint64_t seed = d.n;
+  for (std::size_t i = 0; i < pos.size(); i++) pos[i] = i * stratum + splitmix64(seed) % stratum;
+  d.sample_size = pos.size();
+
+  std::size_t up = 0, down = 0;
+  for (std::size_t i = 1; i < pos.size(); i++) {
+    if (less(first[pos[i]], first[pos[i - 1]])) down++;
+    else if (less(first[pos[i - 1]], first[pos[i]])) up++;
+  }
+  d.global_disorder = std::min(up, down);
+
+  using Key = std::remove_cvref_t<std::indirect_result_t<Proj&, I>>;
+  if constexpr (is_radix_key_v<Key>) {
+    d.has_key_range = true;
+    d.min_key = UINT64_MAX;
+    for (std::size_t p : pos) {
+      std::uint64_t key = to_radix_key(std::invoke(proj, first[p]));
+      d.min_key = std::min(d.min_key, key);
+      d.max_key = std::max(d.max_key, key);
+    }
+  }
+
+  if (!count_distinct) return;
+  std::sort(pos.begin(), pos.end(),
+            [&](std::size_t a, std::size_t b) { return less(first[a], first[b]); });
+  d.sample_distinct = 1;
+  for (std::size_t i = 1; i < pos.size(); i++) {
+    d.sample_distinct += less(first[pos[i - 1]], first[pos[i]]);
+  }
+}
+
+// Replaces the sampled key range by the exact one, in one pass over the range.
+template <typename I, typename Proj>
+void exact_key_range(I first, SortDecision& d, Proj& proj) {
+  using Key = std::remove_cvref_t<std::indirect_result_t<Proj&, I>>;
+  using U = radix_key_t<Key>;
+  U lo = static_cast<U>(-1), hi = 0;
+  for (std::size_t i = 0; i < d.n; i++) {
+    U key = to_radix_key(std::invoke(proj, first[i]));
+    lo = std::min(lo, key);
+    hi = std::max(hi, key);
+  }
+  d.min_key = lo;
+  d.max_key = hi;
+  d.key_range_exact = true;
+}
+
+/**
+ * @brief Pick the algorithm sort() would use for [first, last), without sorting it.
+ */
+template <typename I, typename S, typename Comp = std::ranges::less,
+          typename Proj = std::identity>
+  requires std::random_access_iterator<I> && std::sentinel_for<S, I> &&
+           std::indirect_strict_weak_order<Comp, std::projected<I, Proj>>
+SortDecision choose_sort(I first, S last, Comp comp = {}, Proj proj = {}) {
+  using Value = std::iter_value_t<I>;
+  constexpr SortPath path = sort_path<I, Comp, Proj>();
+  auto less = projected_less(comp, proj);
+
+  SortDecision d;
+  d.n = std::ranges::next(first, last) - first;
+  if (d.n <= INSERTION_SORT_THRESHOLD) {
+    d.algorithm = SortAlgorithm::Insertion;
+    return d;
+  }
+
+  if (d.n >= DISPATCH_SAMPLE_THRESHOLD) {
+    d.sampled = true;
+    sample_local_disorder(first, d, less);
+    sample_positions(first, d, less, proj, path == SortPath::Introsort);
+
+    bool long_runs;
+    if constexpr (path == SortPath::Introsort) {
+      long_runs = d.local_disorder * DISPATCH_COMPARISON_DISORDER <= d.window_pairs;
+    }
+    else {
+      long_runs = d.local_disorder * DISPATCH_LOCAL_DISORDER <= d.window_pairs &&
+                  d.global_disorder * DISPATCH_GLOBAL_DISORDER <= d.sample_size;
+    }
+    if (long_runs) {
+      d.algorithm = SortAlgorithm::AdaptiveMerge;
+      return d;
+    }
+
+    // The sample's range is a lower bound of the real one, so only a small sampled
+    // range is worth the exact pass.
+    if constexpr (is_countable_v<I, Comp, Proj>) {
+      std::size_t max_range = d.n / COUNTING_SORT_DENSITY;
+      if (d.max_key - d.min_key < max_range) {
+        exact_key_range(first, d, proj);
+        if (d.max_key - d.min_key < max_range) {
+          d.algorithm = SortAlgorithm::Counting;
+          return d;
+        }
+      }
+    }
+
+    if constexpr (path == SortPath::Introsort) {
+      if (d.sample_distinct * DISPATCH_FEW_DISTINCT <= d.sample_size) {
+        d.algorithm = SortAlgorithm::ThreeWay;
+        return d;
+      }
+    }
+
+    if constexpr (path == SortPath::SimdIntrosort) {
+      if (d.n >= PARALLEL_DISPATCH_THRESHOLD && std::thread::hardware_concurrency() > 1) {
+        d.algorithm = SortAlgorithm::Parallel;
+        return d;
+      }
+    }
+  }
+
+  if constexpr (path == SortPath::SimdIntrosort) {
+    d.algorithm = d.n <= INT_MAX ? SortAlgorithm::SimdIntrosort : SortAlgorithm::Radix;
+  }
+  else if constexpr (path == SortPath::Radix) {
+    if (d.n < GENERIC_RADIX_THRESHOLD) d.algorithm = SortAlgorithm::Introsort;
+    else if (sizeof(Value) >= KEY_INDEX_MIN_BYTES) d.algorithm = SortAlgorithm::KeyIndex;
+    else d.algorithm = SortAlgorithm::Radix;
+  }
+  else {
+    d.algorithm = SortAlgorithm::Introsort;
+  }
+  return d;
+}
+
+/**
+ * @brief Sort [first, last) with the fastest algorithm for its key type and shape.
+ * @return The decision of choose_sort() that was executed.
+ */
+template <typename I, typename S, typename Comp = std::ranges::less,
+          typename Proj = std::identity>
+  requires std::random_access_iterator<I> && std::sentinel_for<S, I> &&
+           std::sortable<I, Comp, Proj>
+SortDecision sort(I first, S last, Comp comp = {}, Proj proj = {}) {
+  using Value = std::iter_value_t<I>;
+  constexpr SortPath path = sort_path<I, Comp, Proj>();
+  I end = std::ranges::next(first, last);
+  SortDecision d = choose_sort(first, end, comp, proj);
+  std::size_t n = d.n;
+
+  if (d.algorithm == SortAlgorithm::Insertion) {
+    auto less = projected_less(comp, proj);
+    generic_insertion_sort(first, end, less);
+    return d;
+  }
+  if (d.algorithm == SortAlgorithm::AdaptiveMerge) {
+    merge_sort(first, end, std::move(comp), std::move(proj));
+    return d;
+  }
+  if (d.algorithm == SortAlgorithm::ThreeWay) {
+    auto less = projected_less(comp, proj);
+    int depth_limit = 2 * std::bit_width(n);
+    generic_three_way_loop(first, end, depth_limit, less);
+    return d;
+  }
+
+  if constexpr (path == SortPath::SimdIntrosort) {
+    if (d.algorithm == SortAlgorithm::SimdIntrosort) {
+      quick_sort(std::to_address(first), 0, static_cast<int>(n) - 1);
+      return d;
+    }
+    if (d.algorithm == SortAlgorithm::Parallel) {
+      WorkStealingPool pool(0);
+      parallel_sort(std::to_address(first), n, pool);
+      return d;
+    }
+  }
+
+  if constexpr (is_countable_v<I, Comp, Proj>) {
+    if (d.algorithm == SortAlgorithm::Counting) {
+      // Back from radix keys: only signed integers had their sign bit flipped.
+      using U = radix_key_t<Value>;
+      U sign_bit = std::is_signed_v<Value> ? U(1) << (sizeof(U) * 8 - 1) : U(0);
+      Value min_key = static_cast<Value>(static_cast<U>(d.min_key) ^ sign_bit);
+      Value max_key = static_cast<Value>(static_cast<U>(d.max_key) ^ sign_bit);
+      counting_sort(std::to_address(first), n, min_key, max_key);
+      return d;
+    }
+  }
+
+  if constexpr (path != SortPath::Introsort) {
+    if (d.algorithm == SortAlgorithm::KeyIndex) {
+      key_index_sort(first, end, std::move(comp), std::move(proj));
+      return d;
+    }
+    if (d.algorithm == SortAlgorithm::Radix) {
+      std::vector<Value> tmp(n);
+      lsd_radix_sort(std::to_address(first), tmp.data(), n,
+                     [&](const Value& x) { return to_radix_key(std::invoke(proj, x)); });
+      return d;
+    }
+  }
+
+  quick_sort(first, end, std::move(comp), std::move(proj));
+  return d;
+}
+
+// sort(first, last) and sort(first, last, comp) have the same signatures as
+// std::sort, which argument dependent lookup finds for standard iterators. Being
+// more constrained, these overloads win over it instead of being ambiguous.
+template <typename I>
+  requires std::random_access_iterator<I> && std::sortable<I>
+SortDecision sort(I first, I last) {
+  return sort(first, last, std::ranges::less(), std::identity());
+}
+
+template <typename I, typename Comp>
+  requires std::random_access_iterator<I> && std::sortable<I, Comp>
+SortDecision sort(I first, I last, Comp comp) {
+  return sort(first, last, std::move(comp), std::identity());
+}
+
+template <typename R, typename Comp = std::ranges::less, typename Proj = std::identity>
+  requires std::ranges::random_access_range<R> &&
+           std::sortable<std::ranges::iterator_t<R>, Comp, Proj>
+SortDecision sort(R&& range, Comp comp = {}, Proj proj = {}) {
+  return sort(std::ranges::begin(range), std::ranges::end(range), std::move(comp),
+              std::move(proj));
+}
+
+// The most common call, sort(v) on a vector of ints, as an exact match so that no
+// other sort(std::vector<int>&) can take it past the dispatcher.
+inline SortDecision sort(std::vector<int>& arr) {
+  return sort(arr.begin(), arr.end());
+}
+
+/**
+ * @brief Rearrange [first, last) so that *nth is the element a sort would put there,
+ *        with no greater element before it and no smaller one after it.
+ * @return nth
+ */
+template <typename I, typename S, typename Comp = std::ranges::less,
+          typename Proj = std::identity>
+  requires std::random_access_iterator<I> && std::sentinel_for<S, I> &&
+           std::sortable<I, Comp, Proj>
+I quick_select(I first, I nth, S last, Comp comp = {}, Proj proj = {}) {
+  I end = std::ranges::next(first, last);
+  if (nth == end) return nth;
+
+  if constexpr (sort_path<I, Comp, Proj>() == SortPath::SimdIntrosort) {
+    if (end - first <= INT_MAX) {
+      floyd_rivest_select(std::to_address(first), 0, end - first - 1, nth - first);
+      return nth;
+    }
+  }
+
+  auto less = projected_less(comp, proj);
+  generic_introselect(first, nth, end, less);
+  return nth;
+}
+
+template <typename R, typename Comp = std::ranges::less, typename Proj = std::identity>
+  requires std::ranges::random_access_range<R> &&
+           std::sortable<std::ranges::iterator_t<R>, Comp, Proj>
+std::ranges::iterator_t<R> quick_select(R&& range, std::ranges::iterator_t<R> nth,
+                                        Comp comp = {}, Proj proj = {}) {
+  return quick_select(std::ranges::begin(range), nth, std::ranges::end(range), std::move(comp),
+                      std::move(proj));
+}
+
+#endif // end of sort.h definition
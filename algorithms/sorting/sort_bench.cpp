@@ -0,0 +1,394 @@
+/* ====================================================================================
+   Benchmark for the sorting and selection algorithms in this directory. It generates
+   seeded inputs of several shapes, sizes and key types, times sort() (sort.h), the
+   int introsort quick_sort() (quick_sort.h), quick_select() and the std::sort and
+   std::nth_element baselines on them, and prints one JSON record per (key type,
+   distribution, size, algorithm):
+
+     {"type": "int", "distribution": "zipf", "n": 1000000, "algorithm": "sort",
+      "path": "simd_introsort", "reps": 3, "wall_ms": 33.5261, "best_ms": 32.1042,
+      "ns_per_element": 32.1042, "verified": true, "comparisons": 18852167,
+      "swaps": 5465554, "moves": 2070975, "counted_path": "introsort",
+      "peak_rss_kb": 15440}
+
+   wall_ms is the mean over all repetitions, best_ms the fastest one, and
+   ns_per_element is computed from best_ms. Every repetition sorts (or selects in) a
+   fresh copy of the input, the copy is not timed. verified says whether the output
+   of the last repetition is sorted, or for the selections, whether the selected
+   element is the one std::nth_element finds. path is the algorithm sort() chose,
+   as named by sort_algorithm_name() in sort.h.
+
+   The operation counts come from one more, untimed, run on the same input wrapped
+   in Counted<T>, an element type that counts its comparisons, swaps and moves
+   (copies included). The instrumented type is neither an arithmetic key nor
+   ordered by the default comparator of a plain key, so sort() and quick_select()
+   take their comparison paths for it (generic introsort, adaptive merge sort,
+   introselect): the counts describe those, not the radix or SIMD kernels the timed
+   run may have used. For sort() the record names both: path is the algorithm
+   that was timed, counted_path the one the counts come from. quick_sort() only
+   sorts ints and has no counts. Inputs larger than --count-max elements are not
+   counted either.
+
+   Distributions:
+   - uniform:       independent random keys
+   - sorted:        uniform, sorted ascending
+   - reversed:      uniform, sorted descending
+   - organ_pipe:    uniform, ascending up to the middle and descending after it
+   - few_unique:    FEW_UNIQUE_KEYS distinct random keys
+   - all_equal:     a single key
+   - zipf:          keys drawn from ZIPF_KEYS distinct ones with Zipf's law (the
+                    i-th most frequent key with probability proportional to 1 / i^s)
+   - nearly_sorted: sorted, then n / NEARLY_SORTED_SWAP_DIVISOR random pairs swapped
+
+   Usage: sort_bench [--types int,int64,double] [--dists uniform,sorted,...]
+                     [--sizes 1e3,1e4,1e5,1e6] [--algos sort,quick_sort,...]
+                     [--seed 1] [--reps 3] [--count-max 1e7] [--zipf-s 1.0]
+
+   @param --sizes:     element counts, up to 1e9 (an int array of 1e9 elements takes
+                       4 GB, and the benchmark keeps the input and a working copy)
+   @param --algos:     sort, quick_sort, std_sort, quick_select, nth_element
+   @param --count-max: the largest input whose operations are counted
+   @param --zipf-s:    the exponent s of the zipf distribution
+
+   Build in Release mode (-DCMAKE_BUILD_TYPE=Release) to get meaningful numbers.
+=====================================================================================*/
+
+#include "bits/stdc++.h"
+#include <sys/resource.h>
+
+#include "sort.h"
+using namespace std;
+
+const int FEW_UNIQUE_KEYS = 16;
+const int ZIPF_KEYS = 1 << 16;
+const int NEARLY_SORTED_SWAP_DIVISOR = 100;
+
+struct BenchConfig {
+  vector<string> types = {"int", "int64", "double"};
+  vector<string> dists = {"uniform",  "sorted",    "reversed", "organ_pipe",
+                          "few_unique", "all_equal", "zipf",     "nearly_sorted"};
+  vector<size_t> sizes = {1000, 10000, 100000, 1000000};
+  vector<string> algos = {"sort", "quick_sort", "std_sort", "quick_select", "nth_element"};
+  uint64_t seed = 1;
+  int reps = 3;
+  size_t count_max = 10000000;
+  double zipf_s = 1.0;
+};
+
+// Comparisons, swaps and moves made by the Counted<T> elements.
+struct OpCounts {
+  uint64_t comparisons = 0;
+  uint64_t swaps = 0;
+  uint64_t moves = 0;
+};
+
+OpCounts op_counts;
+
+template <typename T>
+struct Counted {
+  T value{};
+
+  Counted() = default;
+  explicit Counted(T v) : value(v) {}
+  Counted(const Counted& other) : value(other.value) { op_counts.moves++; }
+  Counted(Counted&& other) noexcept : value(other.value) { op_counts.moves++; }
+  Counted& operator=(const Counted& other) {
+    value = other.value;
+    op_counts.moves++;
+    return *this;
+  }
+  Counted& operator=(Counted&& other) noexcept {
+    value = other.value;
+    op_counts.moves++;
+    return *this;
+  }
+
+  friend bool operator<(const Counted& a, const Counted& b) {
+    op_counts.comparisons++;
+    return a.value < b.value;
+  }
+  friend bool operator>(const Counted& a, const Counted& b) { return b < a; }
+  friend bool operator<=(const Counted& a, const Counted& b) { return !(b < a); }
+  friend bool operator>=(const Counted& a, const Counted& b) { return !(a < b); }
+  friend bool operator==(const Counted& a, const Counted& b) {
+    op_counts.comparisons++;
+    return a.value == b.value;
+  }
+
+  friend void swap(Counted& a, Counted& b) noexcept {
+    std::swap(a.value, b.value);
+    op_counts.swaps++;
+  }
+};
+
+vector<string> split(const string& s, char sep) {
+  vector<string> parts;
+  stringstream ss(s);
+  string part;
+  while (getline(ss, part, sep)) {
+    if (!part.empty()) parts.push_back(part);
+  }
+  return parts;
+}
+
+long peak_rss_kb() {
+  rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss; // kilobytes on Linux
+}
+
+template <typename T>
+T random_key(mt19937_64& rng) {
+  if constexpr (is_floating_point_v<T>) {
+    return uniform_real_distribution<T>(-1e9, 1e9)(rng);
+  }
+  else {
+    return static_cast<T>(rng());
+  }
+}
+
+template <typename T>
+vector<T> make_input(const string& dist, size_t n, const BenchConfig& cfg) {
+  mt19937_64 rng(cfg.seed ^ (n * 0x9e3779b97f4a7c15ULL));
+  vector<T> arr(n);
+
+  if (dist == "few_unique" || dist == "all_equal") {
+    vector<T> keys(dist == "all_equal" ? 1 : FEW_UNIQUE_KEYS);
+    for (T& key : keys) key = random_key<T>(rng);
+    for (T& x : arr) x = keys[rng() % keys.size()];
+    return arr;
+  }
+
+  if (dist == "zipf") {
+    vector<T> keys(ZIPF_KEYS);
+    for (T& key : keys) key = random_key<T>(rng);
+    vector<double> cdf(ZIPF_KEYS);
+    double total = 0;
+    for (int i = 0; i < ZIPF_KEYS; i++) {
+      total += 1.0 / pow(i + 1, cfg.zipf_s);
+      cdf[i] = total;
+    }
+    uniform_real_distribution<double> unit(0, total);
+    for (T& x : arr) {
+      size_t rank = upper_bound(cdf.begin(), cdf.end(), unit(rng)) - cdf.begin();
+      x = keys[min(rank, keys.size() - 1)];
+    }
+    return arr;
+  }
+
+  for (T& x : arr) x = random_key<T>(rng);
+  if (dist == "uniform") return arr;
+
+  std::sort(arr.begin(), arr.end());
+  if (dist == "sorted") return arr;
+  if (dist == "reversed") {
+    reverse(arr.begin(), arr.end());
+    return arr;
+  }
+  if (dist == "organ_pipe") {
+    // Even ranks ascending, then odd ranks descending.
+    vector<T> pipe;
+    pipe.reserve(n);
+    for (size_t i = 0; i < n; i += 2) pipe.push_back(arr[i]);
+    for (size_t i = n - 1 - (n % 2 == 0 ? 0 : 1); i < n; i -= 2) pipe.push_back(arr[i]);
+    return pipe;
+  }
+  if (dist == "nearly_sorted") {
+    for (size_t i = 0; i < n / NEARLY_SORTED_SWAP_DIVISOR && n > 1; i++) {
+      swap(arr[rng() % n], arr[rng() % n]);
+    }
+    return arr;
+  }
+
+  cerr << "unknown distribution: " << dist << endl;
+  exit(1);
+}
+
+// Runs `run` on a fresh copy of input cfg.reps times and returns {mean, best} wall
+// time in milliseconds. work holds the output of the last run.
+template <typename T, typename F>
+pair<double, double> time_runs(const BenchConfig& cfg, const vector<T>& input, vector<T>& work,
+                               F&& run) {
+  double total = 0, best = numeric_limits<double>::max();
+  for (int r = 0; r < cfg.reps; r++) {
+    work = input;
+    auto start = chrono::steady_clock::now();
+    run(work);
+    auto end = chrono::steady_clock::now();
+    double ms = chrono::duration<double, milli>(end - start).count();
+    total += ms;
+    best = min(best, ms);
+  }
+  return {total / cfg.reps, best};
+}
+
+// Runs `run` once on a Counted copy of input and returns the operations it made.
+template <typename T, typename F>
+OpCounts count_ops(const vector<T>& input, F&& run) {
+  vector<Counted<T>> counted;
+  counted.reserve(input.size());
+  for (const T& x : input) counted.emplace_back(x);
+  op_counts = OpCounts();
+  run(counted);
+  return op_counts;
+}
+
+struct BenchResult {
+  string algorithm;
+  string path;
+  string counted_path;
+  bool skipped = false;
+  double mean_ms = 0;
+  double best_ms = 0;
+  bool verified = false;
+  bool counted = false;
+  OpCounts counts;
+};
+
+void print_record(bool& first, const string& type, const string& dist, size_t n,
+                  const BenchConfig& cfg, const BenchResult& result) {
+  cout << (first ? "  " : ",\n  ");
+  first = false;
+  cout << "{\"type\": \"" << type << "\", \"distribution\": \"" << dist << "\", \"n\": " << n
+       << ", \"algorithm\": \"" << result.algorithm << "\"";
+  if (result.skipped) {
+    cout << ", \"skipped\": true}";
+    return;
+  }
+  if (!result.path.empty()) cout << ", \"path\": \"" << result.path << "\"";
+  double ns = n > 0 ? result.best_ms * 1e6 / n : 0;
+  cout << ", \"reps\": " << cfg.reps << ", \"wall_ms\": " << result.mean_ms
+       << ", \"best_ms\": " << result.best_ms << ", \"ns_per_element\": " << ns
+       << ", \"verified\": " << (result.verified ? "true" : "false");
+  if (result.counted) {
+    cout << ", \"comparisons\": " << result.counts.comparisons
+         << ", \"swaps\": " << result.counts.swaps << ", \"moves\": " << result.counts.moves;
+    if (!result.counted_path.empty()) cout << ", \"counted_path\": \"" << result.counted_path << "\"";
+  }
+  else {
+    cout << ", \"comparisons\": null, \"swaps\": null, \"moves\": null";
+  }
+  cout << ", \"peak_rss_kb\": " << peak_rss_kb() << "}";
+}
+
+template <typename T>
+BenchResult run_algorithm(const string& algo, const vector<T>& input, const BenchConfig& cfg) {
+  BenchResult result;
+  result.algorithm = algo;
+  size_t n = input.size();
+  size_t k = n / 2;
+  bool count = n <= cfg.count_max;
+  vector<T> work;
+
+  // The element std::nth_element puts at k, to check the selections against.
+  auto expected_kth = [&]() {
+    vector<T> copy = input;
+    nth_element(copy.begin(), copy.begin() + k, copy.end());
+    return copy[k];
+  };
+
+  if (algo == "sort") {
+    SortDecision d;
+    tie(result.mean_ms, result.best_ms) =
+        time_runs(cfg, input, work, [&](vector<T>& a) { d = sort(a.begin(), a.end()); });
+    result.path = n > 0 ? sort_algorithm_name(d.algorithm) : "";
+    result.verified = is_sorted(work.begin(), work.end());
+    if (count) {
+      SortDecision counted_d;
+      result.counts = count_ops(input, [&](auto& a) { counted_d = sort(a.begin(), a.end()); });
+      result.counted_path = sort_algorithm_name(counted_d.algorithm);
+    }
+  }
+  else if (algo == "quick_sort") {
+    if constexpr (!is_same_v<T, int>) {
+      result.skipped = true;
+      return result;
+    }
+    else {
+      if (n > INT_MAX) {
+        result.skipped = true;
+        return result;
+      }
+      tie(result.mean_ms, result.best_ms) = time_runs(
+          cfg, input, work, [&](vector<int>& a) { quick_sort(a.data(), 0, int(n) - 1); });
+      result.verified = is_sorted(work.begin(), work.end());
+      count = false;
+    }
+  }
+  else if (algo == "std_sort") {
+    tie(result.mean_ms, result.best_ms) =
+        time_runs(cfg, input, work, [&](vector<T>& a) { std::sort(a.begin(), a.end()); });
+    result.verified = is_sorted(work.begin(), work.end());
+    if (count) result.counts = count_ops(input, [](auto& a) { std::sort(a.begin(), a.end()); });
+  }
+  else if (algo == "quick_select" || algo == "nth_element") {
+    if (n == 0) {
+      result.skipped = true;
+      return result;
+    }
+    auto select = [&](auto& a) {
+      if (algo == "quick_select") quick_select(a.begin(), a.begin() + k, a.end());
+      else std::nth_element(a.begin(), a.begin() + k, a.end());
+    };
+    tie(result.mean_ms, result.best_ms) = time_runs(cfg, input, work, select);
+    result.verified = work[k] == expected_kth();
+    if (count) result.counts = count_ops(input, select);
+  }
+  else {
+    cerr << "unknown algorithm: " << algo << endl;
+    exit(1);
+  }
+
+  result.counted = count;
+  return result;
+}
+
+template <typename T>
+void run_type(const string& type, const BenchConfig& cfg, bool& first) {
+  for (const auto& dist : cfg.dists) {
+    for (size_t n : cfg.sizes) {
+      vector<T> input = make_input<T>(dist, n, cfg);
+      for (const auto& algo : cfg.algos) {
+        print_record(first, type, dist, n, cfg, run_algorithm(algo, input, cfg));
+        cout.flush();
+      }
+    }
+  }
+}
+
+int main(int argc, char* argv[]) {
+  BenchConfig cfg;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    string flag = argv[i], value = argv[i + 1];
+    if (flag == "--types") cfg.types = split(value, ',');
+    else if (flag == "--dists") cfg.dists = split(value, ',');
+    else if (flag == "--algos") cfg.algos = split(value, ',');
+    else if (flag == "--sizes") {
+      cfg.sizes.clear();
+      for (const auto& size : split(value, ',')) cfg.sizes.push_back(size_t(stod(size)));
+    }
+    else if (flag == "--seed") cfg.seed = stoull(value);
+    else if (flag == "--reps") cfg.reps = max(1, stoi(value));
+    else if (flag == "--count-max") cfg.count_max = size_t(stod(value));
+    else if (flag == "--zipf-s") cfg.zipf_s = stod(value);
+    else {
+      cerr << "unknown flag: " << flag << endl;
+      return 1;
+    }
+  }
+
+  bool first = true;
+  cout << "[\n";
+  for (const auto& type : cfg.types) {
+    if (type == "int") run_type<int>(type, cfg, first);
+    else if (type == "int64") run_type<int64_t>(type, cfg, first);
+    else if (type == "double") run_type<double>(type, cfg, first);
+    else {
+      cerr << "unknown type: " << type << endl;
+      return 1;
+    }
+  }
+  cout << "\n]" << endl;
+
+  return 0;
+}
@@ -0,0 +1,37 @@
+/* ====================================================================================
+   This file contains the type traits and helpers shared by the generic sorts
+   (sort.h, merge_sort.h, indirect_sort.h): which comparators are the default
+   ordering, which keys the radix sorts can handle, and the adapter that turns a
+   comparator and a projection into a comparator of elements.
+=====================================================================================*/
+
+#ifndef SORT_TRAITS_H
+#define SORT_TRAITS_H
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+
+// The smallest range the generic sorts hand to a radix sort.
+const std::size_t GENERIC_RADIX_THRESHOLD = 1 << 10;
+
+template <typename Comp, typename Key>
+constexpr bool is_default_order_v = std::is_same_v<Comp, std::ranges::less> ||
+                                    std::is_same_v<Comp, std::less<>> ||
+                                    std::is_same_v<Comp, std::less<Key>>;
+
+// Keys to_radix_key() can map: integers other than bool, float and double.
+template <typename Key>
+constexpr bool is_radix_key_v = std::is_arithmetic_v<Key> && !std::is_same_v<Key, bool> &&
+                                (!std::is_floating_point_v<Key> || sizeof(Key) == 4 ||
+                                 sizeof(Key) == 8);
+
+// Combines a comparator and a projection into a comparator of elements.
+template <typename Comp, typename Proj>
+auto projected_less(Comp& comp, Proj& proj) {
+  return [&](const auto& a, const auto& b) {
+    return std::invoke(comp, std::invoke(proj, a), std::invoke(proj, b));
+  };
+}
+
+#endif // end of sort_traits.h definition
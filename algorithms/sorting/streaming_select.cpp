@@ -0,0 +1,134 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_test_macros.hpp>
+
+#include "bits/stdc++.h"
+#include "streaming_select.h"
+#include "test_util.h"
+using namespace std;
+
+
+vector<int> expected_top(vector<int> arr, size_t k) {
+  std::sort(arr.begin(), arr.end(), greater<>());
+  arr.resize(min(k, arr.size()));
+  return arr;
+}
+
+// The true fraction of sorted elements <= x.
+double true_rank(const vector<double>& sorted, double x) {
+  return double(upper_bound(sorted.begin(), sorted.end(), x) - sorted.begin()) / sorted.size();
+}
+
+TEST_CASE("StreamingTopK class") {
+  for (int n : {0, 1, 10, 1000, 100000}) {
+    vector<vector<int>> inputs = {random_array(n, INT_MIN, INT_MAX, n), random_array(n, INT_MIN, INT_MIN + 3, n),
+                                  sorted_array(n), reversed_array(n), vector<int>(n, INT_MIN)};
+
+    for (const auto& arr : inputs) {
+      for (size_t k : {0, 1, 5, 64, 1000}) {
+        // In one batch, in batches of odd sizes, and one element at a time.
+        StreamingTopK whole(k), batched(k), single(k);
+        whole.push(arr);
+        for (int i = 0; i < n; i += 37) batched.push(arr.data() + i, min(37, n - i));
+        for (int x : arr) single.push(x);
+
+        vector<int> expected = expected_top(arr, k);
+        REQUIRE(whole.top() == expected);
+        REQUIRE(batched.top() == expected);
+        REQUIRE(single.top() == expected);
+
+        vector<int> unsorted = whole.top(false);
+        std::sort(unsorted.begin(), unsorted.end(), greater<>());
+        REQUIRE(unsorted == expected);
+      }
+    }
+  }
+
+  SECTION("merging per-thread instances") {
+    vector<int> arr = random_array(200000, INT_MIN, INT_MAX, 1);
+    vector<StreamingTopK> parts(4, StreamingTopK(100));
+    for (size_t i = 0; i < arr.size(); i++) parts[i % 4].push(arr[i]);
+    StreamingTopK merged(100);
+    for (const auto& part : parts) merged.merge(part);
+    REQUIRE(merged.top() == expected_top(arr, 100));
+  }
+}
+
+TEST_CASE("KllSketch class") {
+  KllSketch<double> empty;
+  REQUIRE(empty.empty());
+  REQUIRE(empty.rank(1.0) == 0);
+
+  SECTION("small streams are exact") {
+    KllSketch<int> sketch;
+    for (int x : {5, 3, 9, 1, 7}) sketch.update(x);
+    REQUIRE(sketch.count() == 5);
+    REQUIRE(sketch.retained() == 5);
+    REQUIRE(sketch.min() == 1);
+    REQUIRE(sketch.max() == 9);
+    REQUIRE(sketch.quantile(0) == 1);
+    REQUIRE(sketch.quantile(0.5) == 5);
+    REQUIRE(sketch.quantile(1) == 9);
+    REQUIRE(sketch.rank(7) == 0.8);
+  }
+
+  SECTION("rank error and memory on large streams") {
+    for (size_t k : {50, 200}) {
+      for (int shape = 0; shape < 3; shape++) {
+        mt19937 rng(k + shape);
+        int n = 1000000;
+        vector<double> values(n);
+        for (int i = 0; i < n; i++) {
+          if (shape == 0) values[i] = uniform_real_distribution<double>(0, 1)(rng);
+          else if (shape == 1) values[i] = i;
+          else values[i] = exponential_distribution<double>(1)(rng);
+        }
+
+        KllSketch<double> sketch(k, k + shape);
+        for (double x : values) sketch.update(x);
+        std::sort(values.begin(), values.end());
+
+        REQUIRE(sketch.count() == uint64_t(n));
+        REQUIRE(sketch.retained() < 3 * k + 64);
+        REQUIRE(sketch.min() == values.front());
+        REQUIRE(sketch.max() == values.back());
+
+        double eps = sketch.normalized_rank_error();
+        vector<double> qs = {0.01, 0.1, 0.25, 0.5, 0.75, 0.9, 0.99, 0.999};
+        vector<double> estimates = sketch.quantiles(qs);
+        for (size_t i = 0; i < qs.size(); i++) {
+          REQUIRE(abs(true_rank(values, estimates[i]) - qs[i]) <= eps);
+          double x = values[size_t(qs[i] * n)];
+          REQUIRE(abs(sketch.rank(x) - true_rank(values, x)) <= eps);
+        }
+      }
+    }
+  }
+
+  SECTION("merging per-thread sketches") {
+    int n = 800000;
+    vector<double> values(n);
+    mt19937 rng(3);
+    for (double& x : values) x = normal_distribution<double>(0, 1)(rng);
+
+    vector<KllSketch<double>> parts;
+    for (int t = 0; t < 8; t++) parts.emplace_back(200, t + 1);
+    for (int i = 0; i < n; i++) parts[i % 8].update(values[i]);
+
+    KllSketch<double> merged(200);
+    for (const auto& part : parts) merged.merge(part);
+    std::sort(values.begin(), values.end());
+
+    REQUIRE(merged.count() == uint64_t(n));
+    REQUIRE(merged.retained() < 3 * 200 + 64);
+    for (double q : {0.5, 0.9, 0.99}) {
+      REQUIRE(abs(true_rank(values, merged.quantile(q)) - q) <= merged.normalized_rank_error());
+    }
+
+    // A sketch with a smaller k lowers the k of the merged one.
+    KllSketch<double> coarse(50, 9);
+    coarse.update(1.0);
+    double eps = merged.normalized_rank_error();
+    merged.merge(coarse);
+    REQUIRE(merged.normalized_rank_error() > eps);
+  }
+}
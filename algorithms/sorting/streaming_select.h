@@ -0,0 +1,285 @@
+/* ====================================================================================
+   This file contains selection over streams: the input arrives in batches of any
+   size, is never stored, and the state is bounded by the parameter k, not by the
+   number of elements seen. Unlike quick_select() neither structure needs the whole
+   array or reorders it, and two instances fed from different threads (or hosts)
+   can be merged.
+
+   - StreamingTopK(k): the exact k largest ints of the stream. It keeps a buffer of
+     up to 2k candidates and a cached threshold, the smallest of the k largest
+     candidates. When the buffer is full, floyd_rivest_select() (quick_select.h)
+     keeps the k largest and the smallest of them becomes the new threshold. Only
+     elements above the threshold can be among the k largest, and a batch is
+     scanned for them with simd_find_greater() (simd_sort.h), so after the first
+     few thousand elements a rejected element costs a fraction of a vector
+     compare. Memory: 2k ints.
+
+   - KllSketch<T>(k): a KLL quantile sketch (Karnin, Lang and Liberty). Items are
+     kept in levels of compactors; an item at level h stands for 2^h items of the
+     stream. Level 0 receives the updates. When the sketch holds as many items as
+     the levels' capacities add up to, the lowest full level is compacted: it is
+     sorted, and either its even or its odd positions (a coin flip) move up one
+     level, the others are dropped. The top level has capacity k and every level
+     below it KLL_CAPACITY_DECAY times the one above (at least KLL_MIN_CAPACITY),
+     so the sketch holds at most about 3k items plus KLL_MIN_CAPACITY per level,
+     O(k + log(n / k)). rank() and quantile() answer with a normalized rank error
+     of at most normalized_rank_error() (about 1.3% for k = 200) with 99%
+     confidence; the error shrinks almost as 1 / k. merge() appends the levels of
+     another sketch and compacts, and gives the same guarantee for the union of
+     the two streams.
+
+   @param k: the number of elements to keep / the accuracy parameter of the sketch
+=====================================================================================*/
+
+#ifndef STREAMING_SELECT_H
+#define STREAMING_SELECT_H
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "parallel_sort.h"
+#include "quick_select.h"
+#include "simd_sort.h"
+
+const std::size_t KLL_DEFAULT_K = 200;
+const std::size_t KLL_MIN_CAPACITY = 2;
+const double KLL_CAPACITY_DECAY = 2.0 / 3.0;
+
+// Fit of the normalized rank error of KLL sketches at 99% confidence, from the
+// Apache DataSketches measurements: KLL_ERROR_SCALE / k^KLL_ERROR_EXPONENT.
+const double KLL_ERROR_SCALE = 2.296;
+const double KLL_ERROR_EXPONENT = 0.9723;
+
+class StreamingTopK {
+  public:
+    explicit StreamingTopK(std::size_t k) : k(k) { buf.reserve(2 * k); }
+
+    /**
+     * @brief Add one element of the stream.
+     */
+    void push(int x) { push(&x, 1); }
+
+    /**
+     * @brief Add the elements arr[0..n) of the stream.
+     */
+    void push(const int* arr, std::size_t n) {
+      if (k == 0) return;
+
+      // Until the buffer has been full once, there is no threshold.
+      std::size_t i = 0;
+      for (; i < n && !has_threshold; i++) {
+        buf.push_back(arr[i]);
+        if (buf.size() == 2 * k) shrink();
+      }
+
+      while ((i += simd_find_greater(arr + i, n - i, threshold)) < n) {
+        buf.push_back(arr[i++]);
+        if (buf.size() == 2 * k) shrink();
+      }
+    }
+
+    void push(const std::vector<int>& batch) { push(batch.data(), batch.size()); }
+
+    /**
+     * @brief Add the candidates of another StreamingTopK, e.g. one per thread.
+     */
+    void merge(const StreamingTopK& other) { push(other.buf.data(), other.buf.size()); }
+
+    /**
+     * @brief Return the min(k, elements seen) largest elements.
+     * @param sorted Return them in descending order.
+     */
+    std::vector<int> top(bool sorted = true) const {
+      std::vector<int> result = buf;
+      if (result.size() > k) {
+        std::size_t drop = result.size() - k;
+        floyd_rivest_select(result.data(), 0, result.size() - 1, drop);
+        result.erase(result.begin(), result.begin() + drop);
+      }
+      if (sorted) std::sort(result.begin(), result.end(), std::greater<>());
+      return result;
+    }
+
+  private:
+    std::size_t k;
+    std::vector<int> buf;
+    int threshold = INT_MIN;
+    bool has_threshold = false;
+
+    // Keeps the k largest elements of buf and makes the smallest of them the threshold.
+    void shrink() {
+      std::size_t drop = buf.size() - k;
+      floyd_rivest_select(buf.data(), 0, buf.size() - 1, drop);
+      threshold = buf[drop];
+      has_threshold = true;
+      buf.erase(buf.begin(), buf.begin() + drop);
+    }
+};
+
+template <typename T>
+class KllSketch {
+  public:
+    explicit KllSketch(std::size_t k = KLL_DEFAULT_K, uint64_t seed = 1)
+        : k(std::max(k, KLL_MIN_CAPACITY)), seed(seed), levels(1) {
+      capacity_total = total_capacity();
+    }
+
+    /**
+     * @brief Add one element of the stream.
+     */
+    void update(const T& x) {
+      if (n == 0 || x < min_item) min_item = x;
+      if (n == 0 || max_item < x) max_item = x;
+      n++;
+      levels[0].push_back(x);
+      n_retained++;
+      while (n_retained >= capacity_total) compress();
+    }
+
+    /**
+     * @brief Add the elements of another sketch, e.g. one per thread or per host.
+     *        If their k differ, the merged sketch keeps the smaller one.
+     */
+    void merge(const KllSketch& other) {
+      if (other.n == 0) return;
+      if (n == 0 || other.min_item < min_item) min_item = other.min_item;
+      if (n == 0 || max_item < other.max_item) max_item = other.max_item;
+      n += other.n;
+      k = std::min(k, other.k);
+
+      if (levels.size() < other.levels.size()) levels.resize(other.levels.size());
+      for (std::size_t h = 0; h < other.levels.size(); h++) {
+        levels[h].insert(levels[h].end(), other.levels[h].begin(), other.levels[h].end());
+        n_retained += other.levels[h].size();
+      }
+      capacity_total = total_capacity();
+      while (n_retained >= capacity_total) compress();
+    }
+
+    // The number of elements seen and the number of items the sketch holds.
+    uint64_t count() const { return n; }
+    std::size_t retained() const { return n_retained; }
+    bool empty() const { return n == 0; }
+
+    // The exact smallest and largest elements seen. The sketch must not be empty.
+    const T& min() const { return min_item; }
+    const T& max() const { return max_item; }
+
+    /**
+     * @brief The bound on the error of rank() and quantile(), as a fraction of count(),
+     *        that holds with 99% confidence.
+     */
+    double normalized_rank_error() const {
+      return KLL_ERROR_SCALE / std::pow(static_cast<double>(k), KLL_ERROR_EXPONENT);
+    }
+
+    /**
+     * @brief Estimate the fraction of the elements that are <= x.
+     */
+    double rank(const T& x) const {
+      if (n == 0) return 0;
+      uint64_t weight = 0;
+      for (std::size_t h = 0; h < levels.size(); h++) {
+        for (const T& item : levels[h]) {
+          if (!(x < item)) weight += uint64_t(1) << h;
+        }
+      }
+      return static_cast<double>(weight) / n;
+    }
+
+    /**
+     * @brief Estimate the element at fraction q (0 <= q <= 1) of the sorted stream,
+     *        e.g. quantile(0.99) for the p99. The sketch must not be empty.
+     */
+    T quantile(double q) const { return quantiles({q})[0]; }
+
+    /**
+     * @brief Estimate several quantiles at once, sorting the items only once.
+     */
+    std::vector<T> quantiles(const std::vector<double>& qs) const {
+      std::vector<std::pair<T, uint64_t>> items;
+      items.reserve(n_retained);
+      for (std::size_t h = 0; h < levels.size(); h++) {
+        for (const T& item : levels[h]) items.emplace_back(item, uint64_t(1) << h);
+      }
+      std::sort(items.begin(), items.end(),
+                [](const auto& a, const auto& b) { return a.first < b.first; });
+
+      // The smallest item whose cumulative weight reaches q * n.
+      std::vector<T> result;
+      result.reserve(qs.size());
+      for (double q : qs) {
+        if (q <= 0) {
+          result.push_back(min_item);
+          continue;
+        }
+        if (q >= 1) {
+          result.push_back(max_item);
+          continue;
+        }
+        double target = q * n;
+        uint64_t weight = 0;
+        std::size_t i = 0;
+        while (i + 1 < items.size() && (weight += items[i].second) < target) i++;
+        result.push_back(items[i].first);
+      }
+      return result;
+    }
+
+  private:
+    std::size_t k;
+    uint64_t seed;
+    uint64_t n = 0;
+    std::size_t n_retained = 0;
+    std::vector<std::vector<T>> levels;
+    std::size_t capacity_total;
+    T min_item{};
+    T max_item{};
+
+    std::size_t capacity(std::size_t h) const {
+      double depth = static_cast<double>(levels.size() - 1 - h);
+      double c = std::ceil(k * std::pow(KLL_CAPACITY_DECAY, depth));
+      return std::max(KLL_MIN_CAPACITY, static_cast<std::size_t>(c));
+    }
+
+    std::size_t total_capacity() const {
+      std::size_t total = 0;
+      for (std::size_t h = 0; h < levels.size(); h++) total += capacity(h);
+      return total;
+    }
+
+    // Compacts the lowest level that is at or over its capacity, adding a level on
+    // top when that is the top one. An odd item out stays where it is.
+    void compress() {
+      std::size_t h = 0;
+      while (levels[h].size() < capacity(h)) h++;
+      if (h + 1 == levels.size()) {
+        levels.emplace_back();
+        capacity_total = total_capacity();
+      }
+
+      std::vector<T>& level = levels[h];
+      std::vector<T>& up = levels[h + 1];
+      std::sort(level.begin(), level.end());
+      std::size_t pairs = level.size() / 2;
+      std::size_t offset = splitmix64(seed) & 1;
+      for (std::size_t i = 0; i < pairs; i++) up.push_back(std::move(level[2 * i + offset]));
+
+      if (level.size() % 2 == 1) {
+        level.front() = std::move(level.back());
+        level.resize(1);
+      }
+      else {
+        level.clear();
+      }
+      n_retained -= pairs;
+    }
+};
+
+#endif // end of streaming_select.h definition
@@ -0,0 +1,90 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_test_macros.hpp>
+
+#include "bits/stdc++.h"
+#include "string_sort.h"
+using namespace std;
+
+// URL-like strings: a few hosts and path segments, so many long shared prefixes.
+vector<string> random_urls(int n, unsigned seed) {
+  mt19937 rng(seed);
+  vector<string> hosts = {"https://example.com/", "https://example.org/", "http://a.io/"};
+  vector<string> segments = {"api/", "v1/", "v2/", "users/", "items/", "search?q=", "x"};
+  vector<string> urls(n);
+  for (string& url : urls) {
+    url = hosts[rng() % hosts.size()];
+    int parts = rng() % 6;
+    for (int i = 0; i < parts; i++) url += segments[rng() % segments.size()];
+    if (rng() % 2) url += to_string(rng() % 1000);
+  }
+  return urls;
+}
+
+vector<string> random_bytes(int n, int max_length, unsigned seed) {
+  mt19937 rng(seed);
+  vector<string> strs(n);
+  for (string& s : strs) {
+    s.resize(rng() % (max_length + 1));
+    for (char& c : s) c = static_cast<char>(rng() % 4 == 0 ? rng() % 256 : 'a' + rng() % 3);
+  }
+  return strs;
+}
+
+void require_sorted_like_std(const vector<string>& strs) {
+  vector<string> expected = strs;
+  std::sort(expected.begin(), expected.end());
+
+  vector<string> mkqs = strs;
+  multikey_quicksort(mkqs);
+  REQUIRE(mkqs == expected);
+
+  vector<string> burst = strs;
+  burstsort(burst);
+  REQUIRE(burst == expected);
+}
+
+TEST_CASE("string sorts with small inputs") {
+  require_sorted_like_std({});
+  require_sorted_like_std({"b"});
+  require_sorted_like_std({"banana", "", "apple", "app", "apple", "", "b"});
+}
+
+TEST_CASE("string sorts with bytes and prefixes") {
+  // Empty strings, embedded zeros, bytes >= 0x80 (negative chars) and strings that
+  // are prefixes of each other.
+  for (int n : {100, 5000, 50000}) {
+    require_sorted_like_std(random_bytes(n, 8, n));
+    require_sorted_like_std(random_bytes(n, 40, n + 1));
+  }
+
+  vector<string> special = {string("a\0b", 3), string("a\0", 2), "a", "\xff", "\x80", "\x7f", ""};
+  require_sorted_like_std(special);
+}
+
+TEST_CASE("string sorts with shared prefixes and duplicates") {
+  require_sorted_like_std(random_urls(100000, 1));
+
+  // Enough equal strings to burst buckets all the way down, and long ones that
+  // differ only at the end.
+  vector<string> equal(20000, "https://example.com/api/v1/users");
+  require_sorted_like_std(equal);
+
+  string prefix(3000, 'p');
+  vector<string> long_strings;
+  for (int i = 0; i < 10000; i++) long_strings.push_back(prefix + to_string(i * 7919 % 10000));
+  require_sorted_like_std(long_strings);
+}
+
+TEST_CASE("string sorts on string views") {
+  vector<string> storage = random_urls(10000, 2);
+  vector<string_view> views(storage.begin(), storage.end());
+  vector<string_view> expected = views;
+  std::sort(expected.begin(), expected.end());
+
+  vector<string_view> mkqs = views;
+  multikey_quicksort(mkqs);
+  REQUIRE(mkqs == expected);
+
+  burstsort(views);
+  REQUIRE(views == expected);
+}
@@ -0,0 +1,266 @@
+/* ====================================================================================
+   This file contains sorts specialized for strings, which never compare the prefix
+   that a group of strings is already known to share.
+
+   A comparison sort compares whole strings, so strings with long common prefixes
+   (URLs, paths, keys with a shared namespace) have that prefix read again in every
+   one of the log2(n) comparisons they take part in. Both algorithms here look at
+   each character of the distinguishing prefixes a constant number of times on
+   average, and sort in place of the strings an array of StringRefs (a view of the
+   characters plus the original index), so the strings themselves move once.
+
+   - multikey_quicksort(arr): multikey (three-way radix) quicksort, Bentley and
+     Sedgewick. It partitions the range by the "character" at the current depth into
+     <, == and > the pivot character (median of three), sorts the < and > parts at
+     the same depth and the == part one character deeper, where every string shares
+     one more character. The characters are MKQS_CHUNK = 7 bytes wide (key_at()):
+     the bytes in the high 56 bits of an integer and, in the low byte, how many of
+     them the string has, so a string that ends sorts before its extensions. Long
+     shared prefixes therefore take a seventh of the partition passes that single
+     bytes would, and every pass reads one word per string. Ranges of at most
+     MKQS_INSERTION_THRESHOLD strings are insertion sorted, comparing from the
+     current depth. It loops on the largest of the three parts and recurses into the
+     others, so the stack depth is O(log n).
+
+   - burstsort(arr): Sinha and Zobel's burstsort. Strings are inserted one by one
+     into a burst trie: a trie whose nodes have one slot per byte value (256, so any
+     bytes, not just letters) plus a list of the strings that end at the node. A slot
+     holds either a child node or a bucket of the strings that continue with that
+     byte. When a bucket grows past BURST_THRESHOLD strings it bursts: it is replaced
+     by a node one character deeper and its strings are redistributed. A traversal
+     of the trie in byte order then sorts every bucket with the multikey quicksort,
+     starting at the depth of the bucket. The buckets are small enough to be sorted
+     in cache, and distributing a string costs one array access per character of its
+     distinguishing prefix. Buckets below BURSTSORT_MAX_DEPTH characters never burst,
+     which bounds the depth of the trie (e.g. for many copies of one long string).
+
+   Strings are compared as sequences of unsigned bytes, like std::string's operator<
+   with the default char_traits, so both sorts produce std::sort's order. Neither is
+   stable, but equal strings are indistinguishable.
+
+   @param arr: the strings to sort
+=====================================================================================*/
+
+#ifndef STRING_SORT_H
+#define STRING_SORT_H
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+const std::size_t MKQS_INSERTION_THRESHOLD = 16;
+const std::size_t MKQS_CHUNK = 7;
+const std::size_t BURST_THRESHOLD = 4096;
+const std::size_t BURSTSORT_MAX_DEPTH = 1 << 10;
+
+// A string to sort, and its position in the input.
+struct StringRef {
+  std::string_view str;
+  std::size_t index;
+};
+
+// The character of r at depth, as 1..256, or 0 past the end of the string.
+inline int char_at(const StringRef& r, std::size_t depth) {
+  return depth < r.str.size() ? static_cast<unsigned char>(r.str[depth]) + 1 : 0;
+}
+
+// Insertion sort of strings that share their first depth characters.
+inline void string_insertion_sort(StringRef* arr, std::size_t n, std::size_t depth) {
+  for (std::size_t i = 1; i < n; i++) {
+    StringRef r = arr[i];
+    std::string_view suffix = r.str.substr(depth);
+    std::size_t j = i;
+    while (j > 0 && suffix < arr[j - 1].str.substr(depth)) {
+      arr[j] = arr[j - 1];
+      j--;
+    }
+    arr[j] = r;
+  }
+}
+
+// The MKQS_CHUNK bytes of r from depth in the high bits, big endian so that integer
+// order is byte order, and the number of them the string has in the low byte.
+// Strings that share their first depth characters have size() >= depth.
+inline std::uint64_t key_at(const StringRef& r, std::size_t depth) {
+  std::size_t rem = r.str.size() - depth;
+  const char* p = r.str.data() + depth;
+  std::uint64_t key = 0;
+  if (rem > MKQS_CHUNK) {
+    std::memcpy(&key, p, sizeof(key));
+    if constexpr (std::endian::native == std::endian::little) key = __builtin_bswap64(key);
+    return (key & ~std::uint64_t(0xff)) | MKQS_CHUNK;
+  }
+  for (std::size_t i = 0; i < rem; i++) {
+    key |= std::uint64_t(static_cast<unsigned char>(p[i])) << (56 - 8 * i);
+  }
+  return key | rem;
+}
+
+inline std::uint64_t median_of_three(std::uint64_t a, std::uint64_t b, std::uint64_t c) {
+  if (a < b) return b < c ? b : (a < c ? c : a);
+  return a < c ? a : (b < c ? c : b);
+}
+
+/**
+ * @brief Multikey quicksort of arr[0..n), strings that share their first depth characters.
+ */
+inline void multikey_quicksort(StringRef* arr, std::size_t n, std::size_t depth) {
+  while (n > MKQS_INSERTION_THRESHOLD) {
+    std::uint64_t pivot = median_of_three(key_at(arr[0], depth), key_at(arr[n / 2], depth),
+                                          key_at(arr[n - 1], depth));
+
+    // Dijkstra's three-way partition: [0, lt) < pivot, [lt, i) == pivot, [gt, n) > pivot.
+    std::size_t lt = 0, i = 0, gt = n;
+    while (i < gt) {
+      std::uint64_t key = key_at(arr[i], depth);
+      if (key < pivot) std::swap(arr[lt++], arr[i++]);
+      else if (key > pivot) std::swap(arr[i], arr[--gt]);
+      else i++;
+    }
+
+    // If the pivot's string ends within this chunk, the == part is all equal strings.
+    std::size_t n_less = lt, n_equal = gt - lt, n_greater = n - gt;
+    StringRef* equal = arr + lt;
+    StringRef* greater = arr + gt;
+    if ((pivot & 0xff) < MKQS_CHUNK) n_equal = 0;
+
+    // Loop on the largest part, recurse into the other two.
+    if (n_less >= n_equal && n_less >= n_greater) {
+      multikey_quicksort(equal, n_equal, depth + MKQS_CHUNK);
+      multikey_quicksort(greater, n_greater, depth);
+      n = n_less;
+    }
+    else if (n_greater >= n_equal) {
+      multikey_quicksort(arr, n_less, depth);
+      multikey_quicksort(equal, n_equal, depth + MKQS_CHUNK);
+      arr = greater;
+      n = n_greater;
+    }
+    else {
+      multikey_quicksort(arr, n_less, depth);
+      multikey_quicksort(greater, n_greater, depth);
+      arr = equal;
+      n = n_equal;
+      depth += MKQS_CHUNK;
+    }
+  }
+  string_insertion_sort(arr, n, depth);
+}
+
+// A node of the burst trie at some depth d: every string below it shares d characters.
+struct BurstNode {
+  std::vector<StringRef> ended;  // strings of length d
+  std::array<std::unique_ptr<BurstNode>, 256> children;
+  std::array<std::vector<StringRef>, 256> buckets;
+};
+
+class BurstTrie {
+  public:
+    /**
+     * @brief Add a string to the trie.
+     */
+    void insert(const StringRef& r) {
+      BurstNode* node = &root;
+      std::size_t depth = 0;
+      while (true) {
+        int c = char_at(r, depth);
+        if (c == 0) {
+          node->ended.push_back(r);
+          return;
+        }
+        c--;
+        if (node->children[c]) {
+          node = node->children[c].get();
+          depth++;
+          continue;
+        }
+
+        std::vector<StringRef>& bucket = node->buckets[c];
+        bucket.push_back(r);
+        if (bucket.size() > BURST_THRESHOLD && depth < BURSTSORT_MAX_DEPTH) burst(node, c, depth);
+        return;
+      }
+    }
+
+    /**
+     * @brief Write the strings in sorted order to out, sorting the buckets on the way.
+     * @return The end of the output.
+     */
+    StringRef* collect(StringRef* out) { return collect(&root, 0, out); }
+
+  private:
+    BurstNode root;
+
+    // Replaces the bucket of byte c in node, at depth, by a node one character deeper.
+    void burst(BurstNode* node, int c, std::size_t depth) {
+      auto child = std::make_unique<BurstNode>();
+      for (const StringRef& r : node->buckets[c]) {
+        int next = char_at(r, depth + 1);
+        if (next == 0) child->ended.push_back(r);
+        else child->buckets[next - 1].push_back(r);
+      }
+      node->buckets[c] = std::vector<StringRef>();
+      node->children[c] = std::move(child);
+    }
+
+    StringRef* collect(BurstNode* node, std::size_t depth, StringRef* out) {
+      for (const StringRef& r : node->ended) *out++ = r;
+      for (int c = 0; c < 256; c++) {
+        if (node->children[c]) {
+          out = collect(node->children[c].get(), depth + 1, out);
+        }
+        else if (!node->buckets[c].empty()) {
+          std::vector<StringRef>& bucket = node->buckets[c];
+          multikey_quicksort(bucket.data(), bucket.size(), depth + 1);
+          for (const StringRef& r : bucket) *out++ = r;
+          bucket = std::vector<StringRef>();
+        }
+      }
+      return out;
+    }
+};
+
+// Sorts arr with sort_refs(refs), which sorts the StringRefs of its strings, and
+// then moves every string to its place once.
+template <typename T, typename SortRefs>
+void sort_strings(std::vector<T>& arr, SortRefs sort_refs) {
+  std::vector<StringRef> refs(arr.size());
+  for (std::size_t i = 0; i < arr.size(); i++) refs[i] = {std::string_view(arr[i]), i};
+  sort_refs(refs);
+
+  std::vector<T> sorted;
+  sorted.reserve(arr.size());
+  for (const StringRef& r : refs) sorted.push_back(std::move(arr[r.index]));
+  arr = std::move(sorted);
+}
+
+/**
+ * @brief Sort strings (std::string or std::string_view) with multikey quicksort.
+ */
+template <typename T>
+void multikey_quicksort(std::vector<T>& arr) {
+  sort_strings(arr, [](std::vector<StringRef>& refs) {
+    multikey_quicksort(refs.data(), refs.size(), 0);
+  });
+}
+
+/**
+ * @brief Sort strings (std::string or std::string_view) with burstsort.
+ */
+template <typename T>
+void burstsort(std::vector<T>& arr) {
+  sort_strings(arr, [](std::vector<StringRef>& refs) {
+    BurstTrie trie;
+    for (const StringRef& r : refs) trie.insert(r);
+    trie.collect(refs.data());
+  });
+}
+
+#endif // end of string_sort.h definition
@@ -0,0 +1,44 @@
+/* ====================================================================================
+   This file contains the input builders shared by the tests of the sorting module.
+
+   - random_array(n, min_value, max_value, seed): n uniform ints in
+     [min_value, max_value], the same for the same seed.
+   - sorted_array(n):     0, 1, ..., n - 1
+   - reversed_array(n):   n, n - 1, ..., 1
+   - organ_pipe_array(n): ascending up to the middle, then descending
+=====================================================================================*/
+
+#ifndef TEST_UTIL_H
+#define TEST_UTIL_H
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+inline std::vector<int> random_array(int n, int min_value, int max_value, unsigned seed) {
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<int> dist(min_value, max_value);
+  std::vector<int> arr(n);
+  for (int& x : arr) x = dist(rng);
+  return arr;
+}
+
+inline std::vector<int> sorted_array(int n) {
+  std::vector<int> arr(n);
+  for (int i = 0; i < n; i++) arr[i] = i;
+  return arr;
+}
+
+inline std::vector<int> reversed_array(int n) {
+  std::vector<int> arr(n);
+  for (int i = 0; i < n; i++) arr[i] = n - i;
+  return arr;
+}
+
+inline std::vector<int> organ_pipe_array(int n) {
+  std::vector<int> arr(n);
+  for (int i = 0; i < n; i++) arr[i] = std::min(i, n - i);
+  return arr;
+}
+
+#endif // end of test_util.h definition
@@ -0,0 +1,190 @@
+/* ==============================================================================
+   A small work-stealing thread pool for fork-join style recursion.
+
+   Every thread (the n_threads - 1 workers, plus the thread that owns the pool)
+   has its own task deque. A thread pushes the tasks it spawns onto the back of
+   its own deque and pops from the back (newest first, which keeps recursion
+   depth-first and cache friendly). When its deque is empty it steals from the
+   front of another thread's deque, which takes the oldest and usually largest
+   piece of work.
+
+   Tasks are grouped with a TaskGroup. wait(group) does not block: the waiting
+   thread keeps running (or stealing) tasks until every task of the group has
+   finished, so tasks can spawn and wait on nested groups without deadlocking.
+   If tasks throw, the other tasks of the group still run to completion and wait()
+   then rethrows the first exception.
+
+   Usage:
+     WorkStealingPool pool(4);
+     TaskGroup group;
+     pool.spawn(group, [&] { ... });
+     pool.spawn(group, [&] { ... });
+     pool.wait(group);
+===============================================================================*/
+
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+struct TaskGroup {
+  std::atomic<int> pending{0};
+
+  // The first exception thrown by a task of the group, rethrown by wait().
+  std::mutex error_mutex;
+  std::exception_ptr error;
+};
+
+class WorkStealingPool {
+  public:
+    /**
+     * @brief Start a pool that runs tasks on n_threads threads, including the
+     *        calling thread (which only runs tasks while it waits).
+     * @param n_threads The number of threads, hardware_concurrency() if <= 0.
+     */
+    explicit WorkStealingPool(int n_threads = 0) {
+      if (n_threads <= 0) n_threads = std::max(1u, std::thread::hardware_concurrency());
+
+      for (int i = 0; i < n_threads; i++) queues.push_back(std::make_unique<Queue>());
+      for (int i = 1; i < n_threads; i++) {
+        workers.emplace_back([this, i] { worker_loop(i); });
+      }
+    }
+
+    ~WorkStealingPool() {
+      {
+        std::lock_guard<std::mutex> lock(idle_mutex);
+        stop = true;
+      }
+      idle_cv.notify_all();
+      for (auto& worker : workers) worker.join();
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    int size() const { return queues.size(); }
+
+    /**
+     * @brief Queue f() as a task of group on the calling thread's deque.
+     */
+    template <typename F>
+    void spawn(TaskGroup& group, F&& f) {
+      group.pending.fetch_add(1, std::memory_order_relaxed);
+      Queue& q = *queues[self()];
+      {
+        std::lock_guard<std::mutex> lock(q.mutex);
+        q.tasks.emplace_back([&group, f = std::forward<F>(f)]() mutable {
+          // An exception must not leave the task: on a worker it would terminate,
+          // and pending must drop even so, or the group's wait() would never end.
+          try {
+            f();
+          }
+          catch (...) {
+            std::lock_guard<std::mutex> lock(group.error_mutex);
+            if (!group.error) group.error = std::current_exception();
+          }
+          group.pending.fetch_sub(1, std::memory_order_release);
+        });
+      }
+      n_queued.fetch_add(1, std::memory_order_release);
+
+      // Taking the lock orders this notify after a worker's check of n_queued,
+      // so the wakeup can't be lost.
+      { std::lock_guard<std::mutex> lock(idle_mutex); }
+      idle_cv.notify_one();
+    }
+
+    /**
+     * @brief Run tasks until every task spawned in group has finished, then rethrow
+     *        the first exception one of them threw, if any.
+     */
+    void wait(TaskGroup& group) {
+      int id = self();
+      while (group.pending.load(std::memory_order_acquire) > 0) {
+        if (!run_one(id)) std::this_thread::yield();
+      }
+      if (group.error) std::rethrow_exception(std::exchange(group.error, nullptr));
+    }
+
+  private:
+    struct Queue {
+      std::mutex mutex;
+      std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<int> n_queued{0};
+    std::mutex idle_mutex;
+    std::condition_variable idle_cv;
+    bool stop = false;
+
+    // Index of the calling thread's deque: its worker id, 0 for other threads.
+    int self() const {
+      return current_pool() == this ? current_id() : 0;
+    }
+
+    static const WorkStealingPool*& current_pool() {
+      thread_local const WorkStealingPool* pool = nullptr;
+      return pool;
+    }
+
+    static int& current_id() {
+      thread_local int id = 0;
+      return id;
+    }
+
+    // Pops a task from the back of our own deque, or steals one from the front of
+    // another, and runs it. Returns false if every deque was empty.
+    bool run_one(int id) {
+      std::function<void()> task;
+      int n = queues.size();
+      for (int k = 0; k < n && !task; k++) {
+        Queue& q = *queues[(id + k) % n];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (q.tasks.empty()) continue;
+
+        if (k == 0) {
+          task = std::move(q.tasks.back());
+          q.tasks.pop_back();
+        }
+        else {
+          task = std::move(q.tasks.front());
+          q.tasks.pop_front();
+        }
+      }
+      if (!task) return false;
+
+      n_queued.fetch_sub(1, std::memory_order_relaxed);
+      task();
+      return true;
+    }
+
+    void worker_loop(int id) {
+      current_pool() = this;
+      current_id() = id;
+
+      while (true) {
+        if (run_one(id)) continue;
+
+        std::unique_lock<std::mutex> lock(idle_mutex);
+        idle_cv.wait(lock, [this] {
+          return stop || n_queued.load(std::memory_order_acquire) > 0;
+        });
+        if (stop) return;
+      }
+    }
+};
+
+#endif // end of work_stealing_pool.h definition
@@ -3,12 +3,19 @@
    it implements the Quick-Union variant, with union by rank and path compression
    optimization.
 
+   It also provides ConcurrentDisjointSet, a lock-free variant that can be shared
+   by many threads. It links roots by id (the larger root is hooked under the
+   smaller one with a compare-and-swap) instead of by rank, so the root of every
+   set is always its smallest element, and it uses path halving in `find()`.
+
    @author: Muhammad Fadli Alim Arsani
 ===============================================================================*/
 
 #ifndef DISJOINTSET_H
 #define DISJOINTSET_H
 
+#include <atomic>
+#include <utility>
 #include <vector>
 
 class DisjointSet {
@@ -58,4 +65,82 @@ class DisjointSet {
     std::vector<int> rank;
 };
 
+class ConcurrentDisjointSet {
+  public:
+    ConcurrentDisjointSet(int size) : root(size) {
+      for (int i=0; i<size; i++) {
+        root[i].store(i, std::memory_order_relaxed);
+      }
+    }
+
+    /**
+     * @brief Find the root of the set containing i, halving the path on the way.
+     * @param i The element.
+     * @return The root of the set containing i (its smallest element once all
+     *         merges have completed).
+     */
+    int find(int i) {
+      while (true) {
+        int parent = root[i].load(std::memory_order_relaxed);
+        int grandparent = root[parent].load(std::memory_order_relaxed);
+        if (parent == grandparent) {
+          return parent;
+        }
+
+        // Losing this race is harmless: another thread shortened the path.
+        root[i].compare_exchange_weak(parent, grandparent, std::memory_order_relaxed);
+        i = grandparent;
+      }
+    }
+
+    /**
+     * @brief Merge the sets containing i and j. Safe to call concurrently.
+     * @param i An element of the first set.
+     * @param j An element of the second set.
+     */
+    void merge(int i, int j) {
+      while (true) {
+        int root_i = find(i);
+        int root_j = find(j);
+        if (root_i == root_j) {
+          return;
+        }
+
+        // Always hook the larger root under the smaller one, so parents only
+        // ever decrease and concurrent links can never form a cycle.
+        if (root_i < root_j) {
+          std::swap(root_i, root_j);
+        }
+        int expected = root_i;
+        if (root[root_i].compare_exchange_strong(expected, root_j, std::memory_order_relaxed)) {
+          return;
+        }
+        i = root_i;
+        j = root_j;
+      }
+    }
+
+    bool connected(int i, int j) {
+      return find(i) == find(j);
+    }
+
+    /**
+     * @brief Point i directly at its root.
+     * @param i The element.
+     * @return The root of the set containing i.
+     */
+    int compress(int i) {
+      int r = find(i);
+      root[i].store(r, std::memory_order_relaxed);
+      return r;
+    }
+
+    int size() const {
+      return root.size();
+    }
+
+  private:
+    std::vector<std::atomic<int>> root;
+};
+
 #endif // end of disjointset.h definition
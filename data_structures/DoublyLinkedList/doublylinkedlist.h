@@ -1,9 +1,33 @@
+/* ==============================================================================
+   This is an implementation of a doubly linked list.
+
+   The nodes are allocated with Allocator (rebound to Node), std::allocator<T>
+   by default. PmrDoublyLinkedList<T> takes a std::pmr::memory_resource instead,
+   e.g. a NodePool (NodePool/nodepool.h). Allocators are copied, moved and
+   propagated the same way as in LinkedList (LinkedList/linkedlist.h).
+
+   push_front(), push_back() and insert() have rvalue overloads that move the data
+   into the node, and emplace_front(), emplace_back() and emplace() construct it
+   in place from the arguments of one of T's constructors.
+
+   splice() moves a whole list (in O(1)), one node or a range of nodes from
+   another list (or from this one) by relinking them, merge() merges two sorted
+   lists, and sort() is a bottom-up merge sort that only relinks nodes. None of
+   them allocate, with the same exception as in LinkedList: between lists with
+   unequal allocators the data is moved into new nodes.
+===============================================================================*/
+
 #ifndef DOUBLYLINKEDLIST_H
 #define DOUBLYLINKEDLIST_H
 
+#include <functional>
 #include <iostream>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
 
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>>
 class DoublyLinkedList
 {
   public:
@@ -15,36 +39,38 @@ class DoublyLinkedList
 
       Node(const T& data, Node* next = nullptr, Node* prev = nullptr)
           : data(data), next(next), prev(prev) {}
+
+      // Constructs data in place from args.
+      template <typename... Args>
+      Node(std::in_place_t, Node* next, Node* prev, Args&&... args)
+          : data(std::forward<Args>(args)...), next(next), prev(prev) {}
     };
     using node_ptr = Node*;
+    using allocator_type = Allocator;
 
     // Constructor
     DoublyLinkedList(): head(nullptr), tail(nullptr), n_nodes(0) {}
 
+    explicit DoublyLinkedList(const Allocator& alloc)
+        : head(nullptr), tail(nullptr), n_nodes(0), alloc(alloc) {}
+
     // Copy constructor, deep copy
-    DoublyLinkedList(const DoublyLinkedList& other) {
-      if (other.head == nullptr) {
-        this->head = nullptr;
-        this->tail = nullptr;
-        this->n_nodes = 0;
+    DoublyLinkedList(const DoublyLinkedList& other)
+        : head(nullptr), tail(nullptr), n_nodes(0),
+          alloc(node_traits::select_on_container_copy_construction(other.alloc)) {
+      // The destructor does not run if a constructor throws, so free the nodes
+      // copied so far here.
+      try {
+        this->copy_nodes(other);
       }
-      else {
-        this->head = new Node(other.head->data);
-        node_ptr curr = this->head;
-        node_ptr other_curr = other.head->next;
-        while (other_curr != nullptr) {
-          curr->next = new Node(other_curr->data);
-          curr->next->prev = curr;
-          curr = curr->next;
-          other_curr = other_curr->next;
-        }
-        this->tail = curr;
-        this->n_nodes = other.n_nodes;
+      catch (...) {
+        this->clear();
+        throw;
       }
     }
 
     // Move constructor, transfer resource (does not perform deep copy)
-    DoublyLinkedList(DoublyLinkedList&& other) noexcept {
+    DoublyLinkedList(DoublyLinkedList&& other) noexcept : alloc(std::move(other.alloc)) {
       this->head = other.head;
       this->tail = other.tail;
       this->n_nodes = other.n_nodes;
@@ -60,31 +86,34 @@ class DoublyLinkedList
 
     // Assignment operator, deep copy
     DoublyLinkedList& operator=(const DoublyLinkedList& other) {
-      this->clear();
-      if (other.head == nullptr) {
-        this->head = nullptr;
-        this->tail = nullptr;
-        this->n_nodes = 0;
+      if (this == &other) {
+        return *this;
       }
-      else {
-        this->head = new Node(other.head->data);
-        node_ptr curr = this->head;
-        node_ptr other_curr = other.head->next;
-        while (other_curr != nullptr) {
-          curr->next = new Node(other_curr->data);
-          curr->next->prev = curr;
-          curr = curr->next;
-          other_curr = other_curr->next;
-        }
-        this->tail = curr;
-        this->n_nodes = other.n_nodes;
+      this->clear();
+      if constexpr (node_traits::propagate_on_container_copy_assignment::value) {
+        this->alloc = other.alloc;
       }
+      this->copy_nodes(other);
       return *this;
     }
 
-    // Assignment operator, transfer resource (does not perform deep copy)
-    DoublyLinkedList& operator=(DoublyLinkedList&& other) noexcept {
+    // Assignment operator, transfer resource (does not perform deep copy), unless
+    // the allocators differ and do not propagate
+    DoublyLinkedList& operator=(DoublyLinkedList&& other) noexcept(
+        node_traits::propagate_on_container_move_assignment::value ||
+        node_traits::is_always_equal::value) {
+      if (this == &other) {
+        return *this;
+      }
       this->clear();
+      if constexpr (node_traits::propagate_on_container_move_assignment::value) {
+        this->alloc = std::move(other.alloc);
+      }
+      else if (this->alloc != other.alloc) {
+        this->copy_nodes(std::move(other));
+        other.clear();
+        return *this;
+      }
       this->head = other.head;
       this->tail = other.tail;
       this->n_nodes = other.n_nodes;
@@ -94,13 +123,36 @@ class DoublyLinkedList
       return *this;
     }
 
+    /**
+     * @brief Get a copy of the allocator the list was constructed with.
+     */
+    allocator_type get_allocator() const {
+      return allocator_type(this->alloc);
+    }
+
     /**
      * @brief Insert a new node at the beginning of the list.
      * @param data The data to be stored in the new node.
      * @return The pointer to the new node.
      */
     node_ptr push_front(const T& data) {
-      node_ptr new_node = new Node(data, this->head, nullptr);
+      return this->emplace_front(data);
+    }
+
+    node_ptr push_front(T&& data) {
+      return this->emplace_front(std::move(data));
+    }
+
+    /**
+     * @brief Insert a new node at the beginning of the list, constructing its data
+     *        in place.
+     * @param args The arguments of T's constructor.
+     * @return The pointer to the new node.
+     */
+    template <typename... Args>
+    node_ptr emplace_front(Args&&... args) {
+      node_ptr new_node =
+          this->create_node(std::in_place, this->head, nullptr, std::forward<Args>(args)...);
       if (this->head == nullptr) {
         this->head = new_node;
         this->tail = new_node;
@@ -127,7 +179,10 @@ class DoublyLinkedList
       if (this->head != nullptr) {
         this->head->prev = nullptr;
       }
-      delete temp;
+      else {
+        this->tail = nullptr;
+      }
+      this->destroy_node(temp);
       this->n_nodes--;
 
       return true;
@@ -147,7 +202,22 @@ class DoublyLinkedList
      * @return The pointer to the new node.
      */
     node_ptr push_back(const T& data) {
-      node_ptr new_node = new Node(data, nullptr, this->tail);
+      return this->emplace_back(data);
+    }
+
+    node_ptr push_back(T&& data) {
+      return this->emplace_back(std::move(data));
+    }
+
+    /**
+     * @brief Insert a new node at the end of the list, constructing its data in place.
+     * @param args The arguments of T's constructor.
+     * @return The pointer to the new node.
+     */
+    template <typename... Args>
+    node_ptr emplace_back(Args&&... args) {
+      node_ptr new_node =
+          this->create_node(std::in_place, nullptr, this->tail, std::forward<Args>(args)...);
       if (this->tail == nullptr) {
         this->head = new_node;
         this->tail = new_node;
@@ -177,7 +247,7 @@ class DoublyLinkedList
       else {
         this->head = nullptr;
       }
-      delete temp;
+      this->destroy_node(temp);
       this->n_nodes--;
 
       return true;
@@ -214,14 +284,34 @@ class DoublyLinkedList
       * @return The pointer to the new node.
       */
     node_ptr insert(node_ptr pivot, const T& data) {
+      return this->emplace(pivot, data);
+    }
+
+    node_ptr insert(node_ptr pivot, T&& data) {
+      return this->emplace(pivot, std::move(data));
+    }
+
+    /**
+      * @brief Insert a new node before the given node (pivot), constructing its data
+      *        in place.
+      * @param pivot The node before which the new node is inserted.
+      * @param args The arguments of T's constructor.
+      * @return The pointer to the new node.
+      */
+    template <typename... Args>
+    node_ptr emplace(node_ptr pivot, Args&&... args) {
       if (pivot == nullptr) {
-        return push_front(data);
+        return this->emplace_front(std::forward<Args>(args)...);
       }
 
-      node_ptr new_node = new Node(data, pivot, pivot->prev);
+      node_ptr new_node =
+          this->create_node(std::in_place, pivot, pivot->prev, std::forward<Args>(args)...);
       if (pivot->prev != nullptr) {
         pivot->prev->next = new_node;
       }
+      else {
+        this->head = new_node;
+      }
       pivot->prev = new_node;
       this->n_nodes++;
       return new_node;
@@ -254,7 +344,7 @@ class DoublyLinkedList
           this->tail = pivot_start->prev;
         }
         node_ptr temp = pivot_start->next; // so we can return node after erased node
-        delete pivot_start;
+        this->destroy_node(pivot_start);
         this->n_nodes--;
 
         return temp;
@@ -277,7 +367,7 @@ class DoublyLinkedList
           else {
             this->tail = temp->prev;
           }
-          delete temp;
+          this->destroy_node(temp);
           this->n_nodes--;
           temp = next_node;
         }
@@ -293,13 +383,189 @@ class DoublyLinkedList
       while (curr != nullptr) {
         node_ptr temp = curr;
         curr = curr->next;
-        delete temp;
+        this->destroy_node(temp);
       }
       this->head = nullptr;
       this->tail = nullptr;
       this->n_nodes = 0;
     }
 
+    /**
+     * @brief Forget all nodes in O(1), without destroying or deallocating them.
+     *        Only for lists whose memory is reclaimed all at once afterwards (a
+     *        NodePool in arena mode, std::pmr::monotonic_buffer_resource). The
+     *        destructors of the elements are not run.
+     */
+    void release() {
+      this->head = nullptr;
+      this->tail = nullptr;
+      this->n_nodes = 0;
+    }
+
+    /**
+      * @brief Move all nodes of other before the given node, without reallocating
+      *        them, in O(1).
+      * @param pivot The node before which the nodes are inserted, nullptr for the end.
+      * @param other The list the nodes are taken from, empty afterwards.
+      */
+    void splice(node_ptr pivot, DoublyLinkedList& other) {
+      this->splice(pivot, other, other.head, nullptr);
+    }
+
+    /**
+      * @brief Move one node of other before the given node, in O(1).
+      * @param pivot The node before which the node is inserted, nullptr for the end.
+      * @param node The node to move.
+      */
+    void splice(node_ptr pivot, DoublyLinkedList& other, node_ptr node) {
+      if (node == nullptr || pivot == node) {
+        return;
+      }
+      this->splice(pivot, other, node, node->next);
+    }
+
+    /**
+      * @brief Move the nodes of other from first up to (not including) last before the
+      *        given node, in O(number of nodes moved), or O(1) for all of other.
+      * @param pivot The node before which the nodes are inserted, nullptr for the end.
+      *              It must not be one of the moved nodes.
+      * @param first The first node to move.
+      * @param last The node after the last one to move, nullptr for other's end.
+      */
+    void splice(node_ptr pivot, DoublyLinkedList& other, node_ptr first, node_ptr last) {
+      if (first == nullptr || first == last) {
+        return;
+      }
+
+      // Nodes of another allocator cannot be adopted; move their data instead, one
+      // node at a time. A node leaves other only once its replacement exists here,
+      // so if constructing one throws, every element is still in one of the lists.
+      if (this->alloc != other.alloc) {
+        while (first != last) {
+          node_ptr node = first;
+          first = first->next;
+          if (pivot != nullptr) {
+            this->emplace(pivot, std::move(node->data));
+          }
+          else {
+            this->emplace_back(std::move(node->data));
+          }
+          if (node->prev != nullptr) {
+            node->prev->next = node->next;
+          }
+          else {
+            other.head = node->next;
+          }
+          if (node->next != nullptr) {
+            node->next->prev = node->prev;
+          }
+          else {
+            other.tail = node->prev;
+          }
+          other.n_nodes--;
+          other.destroy_node(node);
+        }
+        return;
+      }
+
+      node_ptr end = last != nullptr ? last->prev : other.tail;
+      unsigned int count = other.n_nodes;
+      if (first != other.head || last != nullptr) {
+        count = 1;
+        for (node_ptr curr = first; curr != end; curr = curr->next) {
+          count++;
+        }
+      }
+
+      // Unlink [first, end] from other.
+      if (first->prev != nullptr) {
+        first->prev->next = last;
+      }
+      else {
+        other.head = last;
+      }
+      if (last != nullptr) {
+        last->prev = first->prev;
+      }
+      else {
+        other.tail = first->prev;
+      }
+      other.n_nodes -= count;
+
+      node_ptr before = pivot != nullptr ? pivot->prev : this->tail;
+      first->prev = before;
+      end->next = pivot;
+      if (before != nullptr) {
+        before->next = first;
+      }
+      else {
+        this->head = first;
+      }
+      if (pivot != nullptr) {
+        pivot->prev = end;
+      }
+      else {
+        this->tail = end;
+      }
+      this->n_nodes += count;
+    }
+
+    /**
+     * @brief Merge the sorted list other into this sorted list, relinking its nodes.
+     *        Equal elements of this list stay before those of other.
+     * @param comp The order the lists are sorted in.
+     */
+    template <typename Compare = std::less<>>
+    void merge(DoublyLinkedList& other, Compare comp = {}) {
+      if (this == &other) {
+        return;
+      }
+      if (this->alloc != other.alloc) {
+        // Move other's elements over one by one, each before the first element of
+        // this list that compares greater.
+        node_ptr curr = this->head;
+        while (other.head != nullptr) {
+          while (curr != nullptr && !comp(other.head->data, curr->data)) {
+            curr = curr->next;
+          }
+          this->splice(curr, other, other.head);
+        }
+        return;
+      }
+      this->head = merge_chains(this->head, other.head, comp);
+      this->n_nodes += other.n_nodes;
+      other.head = nullptr;
+      other.tail = nullptr;
+      other.n_nodes = 0;
+      this->relink_prev();
+    }
+
+    /**
+     * @brief Sort the list with a stable bottom-up merge sort, in O(n log n) time
+     *        and O(1) extra memory. Only links are changed; no node is allocated,
+     *        freed or moved, so pointers to nodes stay valid.
+     * @param comp The order to sort in.
+     */
+    template <typename Compare = std::less<>>
+    void sort(Compare comp = {}) {
+      // Sorts along the next links only, pass p merging neighbouring sorted runs of
+      // width 2^p, and restores the prev links at the end.
+      for (unsigned int width = 1; width < this->n_nodes; width *= 2) {
+        node_ptr rest = this->head;
+        node_ptr* link = &this->head;
+        while (rest != nullptr) {
+          node_ptr left = rest;
+          node_ptr right = cut_after(left, width);
+          rest = cut_after(right, width);
+          *link = merge_chains(left, right, comp);
+          while (*link != nullptr) {
+            link = &(*link)->next;
+          }
+        }
+      }
+      this->relink_prev();
+    }
+
     /**
      * @brief Print the list.
      */
@@ -319,9 +585,100 @@ class DoublyLinkedList
     }
 
   private:
+    using node_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using node_traits = std::allocator_traits<node_allocator>;
+
     node_ptr head;
     node_ptr tail;
     unsigned int n_nodes;
+    [[no_unique_address]] node_allocator alloc;
+
+    template <typename... Args>
+    node_ptr create_node(Args&&... args) {
+      node_ptr node = node_traits::allocate(this->alloc, 1);
+      try {
+        node_traits::construct(this->alloc, node, std::forward<Args>(args)...);
+      }
+      catch (...) {
+        node_traits::deallocate(this->alloc, node, 1);
+        throw;
+      }
+      return node;
+    }
+
+    void destroy_node(node_ptr node) {
+      node_traits::destroy(this->alloc, node);
+      node_traits::deallocate(this->alloc, node, 1);
+    }
+
+    // Cuts the chain of next links starting at node after n nodes and returns the rest.
+    static node_ptr cut_after(node_ptr node, unsigned int n) {
+      for (unsigned int i = 1; node != nullptr && i < n; i++) {
+        node = node->next;
+      }
+      if (node == nullptr) {
+        return nullptr;
+      }
+      node_ptr rest = node->next;
+      node->next = nullptr;
+      return rest;
+    }
+
+    // Merges the sorted chains of next links a and b, taking from a on ties.
+    template <typename Compare>
+    static node_ptr merge_chains(node_ptr a, node_ptr b, Compare& comp) {
+      node_ptr merged = nullptr;
+      node_ptr* link = &merged;
+      while (a != nullptr && b != nullptr) {
+        if (comp(b->data, a->data)) {
+          *link = b;
+          b = b->next;
+        }
+        else {
+          *link = a;
+          a = a->next;
+        }
+        link = &(*link)->next;
+      }
+      *link = a != nullptr ? a : b;
+      return merged;
+    }
+
+    // Sets every prev link, and tail, from the next links.
+    void relink_prev() {
+      node_ptr prev = nullptr;
+      for (node_ptr curr = this->head; curr != nullptr; curr = curr->next) {
+        curr->prev = prev;
+        prev = curr;
+      }
+      this->tail = prev;
+    }
+
+    // Appends copies of the elements of other to this (empty) list, or moves them
+    // out of other if it is an rvalue.
+    template <typename List>
+    void copy_nodes(List&& other) {
+      for (node_ptr curr = other.head; curr != nullptr; curr = curr->next) {
+        node_ptr node;
+        if constexpr (std::is_rvalue_reference_v<List&&>) {
+          node = this->create_node(std::in_place, nullptr, this->tail, std::move(curr->data));
+        }
+        else {
+          node = this->create_node(std::in_place, nullptr, this->tail, curr->data);
+        }
+        if (this->tail == nullptr) {
+          this->head = node;
+        }
+        else {
+          this->tail->next = node;
+        }
+        this->tail = node;
+        this->n_nodes++;
+      }
+    }
 };
 
+template <typename T>
+using PmrDoublyLinkedList = DoublyLinkedList<T, std::pmr::polymorphic_allocator<T>>;
+
 #endif // end of doublylinkedlist.h definition
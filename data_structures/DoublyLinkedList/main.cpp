@@ -3,6 +3,49 @@
 
 #include "bits/stdc++.h"
 #include "doublylinkedlist.h"
+#include "../NodePool/nodepool.h"
+
+// A payload that counts how often it is copied and moved.
+struct Payload {
+    static inline int copies = 0;
+    static inline int moves = 0;
+
+    std::string text;
+    std::vector<char> bytes;
+
+    Payload(std::string text, size_t n) : text(std::move(text)), bytes(n, 'x') {}
+    Payload(const Payload& other) : text(other.text), bytes(other.bytes) { copies++; }
+    Payload(Payload&& other) noexcept : text(std::move(other.text)), bytes(std::move(other.bytes)) {
+        moves++;
+    }
+
+    static void reset() {
+        copies = 0;
+        moves = 0;
+    }
+};
+
+
+// A value whose copy or move constructor throws once copies_left copies or
+// moves_left moves have been made.
+struct ThrowingValue {
+    static inline int copies_left = INT_MAX;
+    static inline int moves_left = INT_MAX;
+
+    int value;
+
+    ThrowingValue(int value) : value(value) {}
+    ThrowingValue(const ThrowingValue& other) : value(other.value) {
+        if (copies_left-- <= 0) {
+            throw std::runtime_error("copy failed");
+        }
+    }
+    ThrowingValue(ThrowingValue&& other) : value(other.value) {
+        if (moves_left-- <= 0) {
+            throw std::runtime_error("move failed");
+        }
+    }
+};
 
 TEST_CASE("DoublyLinkedList - Default Constructor", "[DoublyLinkedList]") {
     DoublyLinkedList<int> custom_list;
@@ -244,3 +287,346 @@ TEST_CASE("DoublyLinkedList - Assignment Operator Transfer Resource", "[DoublyLi
     REQUIRE(moved_it == nullptr);
     REQUIRE(std_it == std_list.end());
 }
+
+TEST_CASE("DoublyLinkedList - Insert Before Head and Pop Last", "[DoublyLinkedList]") {
+    DoublyLinkedList<int> custom_list;
+    auto pivot = custom_list.push_back(2);
+    custom_list.insert(pivot, 1);
+    REQUIRE(custom_list.front()->data == 1);
+    REQUIRE(custom_list.front()->next == pivot);
+
+    custom_list.pop_front();
+    custom_list.pop_front();
+    REQUIRE(custom_list.front() == nullptr);
+    REQUIRE(custom_list.back() == nullptr);
+
+    custom_list.push_back(3);
+    REQUIRE(custom_list.front() == custom_list.back());
+}
+
+TEST_CASE("DoublyLinkedList - Node Pool Recycles Freed Nodes", "[DoublyLinkedList]") {
+    NodePool pool;
+    PmrDoublyLinkedList<int> custom_list(&pool);
+    std::list<int> std_list;
+
+    std::mt19937 rng(1);
+    for (int i = 0; i < 100000; i++) {
+        // Keep about 500 elements while churning at both ends.
+        if (rng() % 1000 < std_list.size()) {
+            if (rng() % 2) {
+                custom_list.pop_front();
+                std_list.pop_front();
+            }
+            else {
+                custom_list.pop_back();
+                std_list.pop_back();
+            }
+        }
+        else {
+            int x = rng();
+            if (rng() % 2) {
+                custom_list.push_front(x);
+                std_list.push_front(x);
+            }
+            else {
+                custom_list.push_back(x);
+                std_list.push_back(x);
+            }
+        }
+    }
+
+    REQUIRE(custom_list.size() == std_list.size());
+    REQUIRE(pool.blocks_in_use() == std_list.size());
+    REQUIRE(pool.slab_count() == 1);
+
+    auto custom_it = custom_list.front();
+    for (int x : std_list) {
+        REQUIRE(custom_it->data == x);
+        custom_it = custom_it->next;
+    }
+    REQUIRE(custom_it == nullptr);
+}
+
+TEST_CASE("DoublyLinkedList - Arena Release and Allocators", "[DoublyLinkedList]") {
+    NodePool arena(NodePoolMode::Arena);
+    PmrDoublyLinkedList<int> custom_list(&arena);
+    for (int i = 0; i < 100000; i++) {
+        custom_list.push_back(i);
+    }
+    custom_list.erase(custom_list.front());
+    REQUIRE(custom_list.front()->data == 1);
+    REQUIRE(arena.blocks_in_use() == 99999);
+
+    // A copy into another arena, then both released without visiting the nodes.
+    NodePool other_arena(NodePoolMode::Arena);
+    PmrDoublyLinkedList<int> copied_list(&other_arena);
+    copied_list = custom_list;
+    REQUIRE(copied_list.size() == 99999);
+    REQUIRE(copied_list.back()->data == 99999);
+    REQUIRE(copied_list.back()->prev->data == 99998);
+    REQUIRE(other_arena.blocks_in_use() == 99999);
+
+    custom_list.release();
+    copied_list.release();
+    arena.release();
+    other_arena.release();
+    REQUIRE(custom_list.empty());
+    REQUIRE(copied_list.back() == nullptr);
+    REQUIRE(arena.slab_count() == 0);
+}
+
+TEST_CASE("DoublyLinkedList - Move and Emplace Without Copies", "[DoublyLinkedList]") {
+    DoublyLinkedList<Payload> custom_list;
+    Payload::reset();
+
+    Payload payload("second", 2048);
+    auto pivot = custom_list.push_back(std::move(payload));
+    custom_list.push_front(Payload("first", 2048));
+    custom_list.emplace_back("fourth", 2048);
+    custom_list.emplace(custom_list.back(), "third", 2048);
+    custom_list.emplace_front("zeroth", 2048);
+    custom_list.insert(pivot, Payload("between", 8));
+    REQUIRE(Payload::copies == 0);
+    REQUIRE(Payload::moves == 3);
+
+    std::vector<std::string> expected = {"zeroth", "first", "between", "second", "third", "fourth"};
+    auto custom_it = custom_list.front();
+    for (const auto& text : expected) {
+        REQUIRE(custom_it->data.text == text);
+        custom_it = custom_it->next;
+    }
+    REQUIRE(custom_it == nullptr);
+
+    auto back_it = custom_list.back();
+    for (auto it = expected.rbegin(); it != expected.rend(); ++it) {
+        REQUIRE(back_it->data.text == *it);
+        back_it = back_it->prev;
+    }
+    REQUIRE(back_it == nullptr);
+
+    NodePool pool_a, pool_b;
+    PmrDoublyLinkedList<Payload> list_a(&pool_a), list_b(&pool_b);
+    list_a.emplace_back("a", 100);
+    list_a.emplace_back("b", 100);
+    Payload::reset();
+    list_b = std::move(list_a);
+    REQUIRE(Payload::copies == 0);
+    REQUIRE(Payload::moves == 2);
+    REQUIRE(list_b.back()->data.text == "b");
+    REQUIRE(list_b.back()->prev == list_b.front());
+}
+
+TEST_CASE("DoublyLinkedList - Move Only Elements", "[DoublyLinkedList]") {
+    DoublyLinkedList<std::unique_ptr<int>> custom_list;
+    custom_list.push_back(std::make_unique<int>(2));
+    custom_list.emplace_front(new int(1));
+    custom_list.emplace_back(new int(4));
+    custom_list.insert(custom_list.back(), std::make_unique<int>(3));
+
+    int expected = 1;
+    for (auto it = custom_list.front(); it != nullptr; it = it->next) {
+        REQUIRE(*it->data == expected++);
+    }
+    REQUIRE(expected == 5);
+    REQUIRE(*custom_list.back()->prev->data == 3);
+}
+
+template <typename List>
+std::vector<int> to_vector(List& custom_list) {
+    std::vector<int> values;
+    for (auto it = custom_list.front(); it != nullptr; it = it->next) {
+        values.push_back(it->data);
+    }
+
+    // The prev links must walk the same list backwards.
+    std::vector<int> backwards;
+    for (auto it = custom_list.back(); it != nullptr; it = it->prev) {
+        backwards.push_back(it->data);
+    }
+    REQUIRE(std::equal(values.rbegin(), values.rend(), backwards.begin(), backwards.end()));
+    REQUIRE(values.size() == custom_list.size());
+    return values;
+}
+
+DoublyLinkedList<int> make_list(const std::vector<int>& values) {
+    DoublyLinkedList<int> custom_list;
+    for (int x : values) {
+        custom_list.push_back(x);
+    }
+    return custom_list;
+}
+
+TEST_CASE("DoublyLinkedList and std::list - Splice", "[DoublyLinkedList]") {
+    DoublyLinkedList<int> custom_list = make_list({1, 2, 3});
+    DoublyLinkedList<int> other = make_list({10, 20, 30, 40, 50});
+    std::list<int> std_list = {1, 2, 3};
+    std::list<int> std_other = {10, 20, 30, 40, 50};
+
+    // One node: 20 before 2.
+    custom_list.splice(custom_list.front()->next, other, other.front()->next);
+    std_list.splice(std::next(std_list.begin()), std_other, std::next(std_other.begin()));
+    REQUIRE(to_vector(custom_list) == std::vector<int>(std_list.begin(), std_list.end()));
+    REQUIRE(to_vector(other) == std::vector<int>(std_other.begin(), std_other.end()));
+
+    // The range [30, 50) at the end.
+    custom_list.splice(nullptr, other, other.front()->next, other.back());
+    std_list.splice(std_list.end(), std_other, std::next(std_other.begin()), std::prev(std_other.end()));
+    REQUIRE(to_vector(custom_list) == std::vector<int>(std_list.begin(), std_list.end()));
+    REQUIRE(to_vector(other) == std::vector<int>(std_other.begin(), std_other.end()));
+
+    // The rest of other at the front.
+    custom_list.splice(custom_list.front(), other);
+    std_list.splice(std_list.begin(), std_other);
+    REQUIRE(to_vector(custom_list) == std::vector<int>(std_list.begin(), std_list.end()));
+    REQUIRE(other.empty());
+    REQUIRE(other.front() == nullptr);
+    REQUIRE(other.back() == nullptr);
+
+    // Within the same list: the last node to the front, the first to the end.
+    custom_list.splice(custom_list.front(), custom_list, custom_list.back());
+    std_list.splice(std_list.begin(), std_list, std::prev(std_list.end()));
+    custom_list.splice(nullptr, custom_list, custom_list.front());
+    std_list.splice(std_list.end(), std_list, std_list.begin());
+    REQUIRE(to_vector(custom_list) == std::vector<int>(std_list.begin(), std_list.end()));
+}
+
+TEST_CASE("DoublyLinkedList - Splice Relinks Nodes Between Pools", "[DoublyLinkedList]") {
+    NodePool pool, other_pool;
+    PmrDoublyLinkedList<int> custom_list(&pool), same_pool(&pool), other(&other_pool);
+    for (int i = 0; i < 100; i++) {
+        same_pool.push_back(i);
+        other.push_back(i);
+    }
+
+    auto node = same_pool.back();
+    custom_list.splice(nullptr, same_pool);
+    REQUIRE(custom_list.back() == node);
+    REQUIRE(pool.blocks_in_use() == 100);
+
+    custom_list.splice(custom_list.front(), other, other.front(), other.front()->next->next);
+    REQUIRE(to_vector(custom_list)[0] == 0);
+    REQUIRE(to_vector(custom_list)[1] == 1);
+    REQUIRE(custom_list.size() == 102);
+    REQUIRE(pool.blocks_in_use() == 102);
+    REQUIRE(other_pool.blocks_in_use() == 98);
+}
+
+TEST_CASE("DoublyLinkedList - Merge", "[DoublyLinkedList]") {
+    std::mt19937 rng(1);
+    for (int n : {0, 1, 5, 1000}) {
+        std::vector<int> a(n), b(n / 2 + 1);
+        for (int& x : a) x = rng() % 100;
+        for (int& x : b) x = rng() % 100;
+        std::sort(a.begin(), a.end());
+        std::sort(b.begin(), b.end());
+        std::vector<int> expected;
+        std::merge(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+
+        DoublyLinkedList<int> custom_list = make_list(a), other = make_list(b);
+        custom_list.merge(other);
+        REQUIRE(to_vector(custom_list) == expected);
+        REQUIRE(other.empty());
+        REQUIRE(other.back() == nullptr);
+    }
+
+    NodePool pool, other_pool;
+    PmrDoublyLinkedList<int> custom_list(&pool), other(&other_pool);
+    for (int x : {1, 4, 7}) custom_list.push_back(x);
+    for (int x : {2, 4, 9}) other.push_back(x);
+    custom_list.merge(other);
+    REQUIRE(to_vector(custom_list) == std::vector<int>{1, 2, 4, 4, 7, 9});
+    REQUIRE(pool.blocks_in_use() == 6);
+    REQUIRE(other_pool.blocks_in_use() == 0);
+}
+
+TEST_CASE("DoublyLinkedList - Bottom Up Merge Sort", "[DoublyLinkedList]") {
+    std::mt19937 rng(2);
+    for (int n : {0, 1, 2, 3, 17, 1000, 1024, 4099}) {
+        std::vector<int> values(n);
+        for (int& x : values) x = rng() % 50;
+        DoublyLinkedList<int> custom_list = make_list(values);
+
+        std::set<const void*> nodes;
+        for (auto it = custom_list.front(); it != nullptr; it = it->next) {
+            nodes.insert(it);
+        }
+
+        custom_list.sort();
+        std::sort(values.begin(), values.end());
+        REQUIRE(to_vector(custom_list) == values);
+
+        std::set<const void*> sorted_nodes;
+        for (auto it = custom_list.front(); it != nullptr; it = it->next) {
+            sorted_nodes.insert(it);
+        }
+        REQUIRE(sorted_nodes == nodes);
+    }
+
+    // Stability, and pointers to nodes stay valid.
+    DoublyLinkedList<std::pair<int, int>> pairs;
+    for (int i = 0; i < 500; i++) {
+        pairs.push_back({int(rng() % 10), i});
+    }
+    auto first = pairs.front();
+    auto first_value = first->data;
+    pairs.sort([](const auto& a, const auto& b) { return a.first < b.first; });
+    REQUIRE(first->data == first_value);
+    for (auto it = pairs.front(); it->next != nullptr; it = it->next) {
+        REQUIRE((it->data.first < it->next->data.first ||
+                 (it->data.first == it->next->data.first && it->data.second < it->next->data.second)));
+    }
+}
+
+TEST_CASE("DoublyLinkedList - Splice And Merge Between Pools When A Move Throws", "[DoublyLinkedList]") {
+    for (bool use_merge : {false, true}) {
+        NodePool pool, other_pool;
+        PmrDoublyLinkedList<ThrowingValue> custom_list(&pool), other(&other_pool);
+        for (int i = 0; i < 10; i++) {
+            other.push_back(ThrowingValue(i));
+        }
+
+        // The fifth element fails to move into this list's pool.
+        ThrowingValue::moves_left = 4;
+        if (use_merge) {
+            REQUIRE_THROWS_AS(custom_list.merge(other, [](const auto& a, const auto& b) {
+                return a.value < b.value;
+            }), std::runtime_error);
+        }
+        else {
+            REQUIRE_THROWS_AS(custom_list.splice(nullptr, other), std::runtime_error);
+        }
+        ThrowingValue::moves_left = INT_MAX;
+
+        // Nothing leaked: each element is in exactly one list, in its pool.
+        REQUIRE(custom_list.size() == 4);
+        REQUIRE(other.size() == 6);
+        REQUIRE(pool.blocks_in_use() == 4);
+        REQUIRE(other_pool.blocks_in_use() == 6);
+        std::vector<int> values;
+        for (auto it = custom_list.front(); it != nullptr; it = it->next) {
+            values.push_back(it->data.value);
+        }
+        for (auto it = other.front(); it != nullptr; it = it->next) {
+            values.push_back(it->data.value);
+        }
+        REQUIRE(values == std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+    }
+}
+
+TEST_CASE("DoublyLinkedList - Copy Constructor When A Copy Throws", "[DoublyLinkedList]") {
+    NodePool pool;
+    PmrDoublyLinkedList<ThrowingValue> other(&pool);
+    for (int i = 0; i < 10; i++) {
+        other.push_back(ThrowingValue(i));
+    }
+
+    // A polymorphic_allocator copy uses the default resource, so make that the pool.
+    // The sixth element fails to copy; the five copied nodes must be freed.
+    std::pmr::memory_resource* previous = std::pmr::set_default_resource(&pool);
+    ThrowingValue::copies_left = 5;
+    REQUIRE_THROWS_AS(PmrDoublyLinkedList<ThrowingValue>(other), std::runtime_error);
+    ThrowingValue::copies_left = INT_MAX;
+    std::pmr::set_default_resource(previous);
+    REQUIRE(pool.blocks_in_use() == 10);
+    REQUIRE(other.size() == 10);
+}
@@ -1,9 +1,40 @@
+/* ==============================================================================
+   This is an implementation of a singly linked list.
+
+   The nodes are allocated with Allocator (rebound to Node), std::allocator<T>
+   by default. PmrLinkedList<T> takes a std::pmr::memory_resource instead, e.g.
+   a NodePool (NodePool/nodepool.h) that recycles freed nodes, or the same pool
+   in arena mode, in which release() drops the whole list in O(1).
+
+   Copies get select_on_container_copy_construction() of the source's allocator,
+   and assignments follow the allocator's propagate_on_container_* traits like
+   the standard containers: a list moved into one with an unequal allocator that
+   does not propagate (two PmrLinkedLists on different resources) has its
+   elements moved into new nodes instead of its nodes taken.
+
+   push_front() and insert_after() have rvalue overloads that move the data into
+   the node, and emplace_front() and emplace_after() construct it in place from
+   the arguments of one of T's constructors, so T need not even be copyable.
+
+   splice_after() moves a whole list, one node or a range of nodes from another
+   list (or from this one) by relinking them, merge() merges two sorted lists,
+   and sort() is a bottom-up merge sort that only relinks nodes. None of them
+   allocate. Nodes only change lists if the allocators compare equal; between
+   lists on different resources, splice_after() and merge() move the data into
+   new nodes instead.
+===============================================================================*/
+
 #ifndef LINKEDLIST_H
 #define LINKEDLIST_H
 
+#include <functional>
 #include <iostream>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
 
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>>
 class LinkedList
 {
   public:
@@ -14,33 +45,38 @@ class LinkedList
 
       Node(const T& data, Node* next = nullptr)
           : data(data), next(next) {}
+
+      // Constructs data in place from args.
+      template <typename... Args>
+      Node(std::in_place_t, Node* next, Args&&... args)
+          : data(std::forward<Args>(args)...), next(next) {}
     };
     using node_ptr = Node*;
+    using allocator_type = Allocator;
 
     // Constructor
     LinkedList(): head(nullptr), n_nodes(0) {}
 
+    explicit LinkedList(const Allocator& alloc)
+        : head(nullptr), n_nodes(0), alloc(alloc) {}
+
     // Copy constructor, deep copy
-    LinkedList(const LinkedList& other) {
-      if (other.head == nullptr) {
-        this->head = nullptr;
-        this->n_nodes = 0;
+    LinkedList(const LinkedList& other)
+        : head(nullptr), n_nodes(0),
+          alloc(node_traits::select_on_container_copy_construction(other.alloc)) {
+      // The destructor does not run if a constructor throws, so free the nodes
+      // copied so far here.
+      try {
+        this->copy_nodes(other);
       }
-      else {
-        this->head = new Node(other.head->data);
-        node_ptr curr = this->head;
-        node_ptr other_curr = other.head->next;
-        while (other_curr != nullptr) {
-          curr->next = new Node(other_curr->data);
-          curr = curr->next;
-          other_curr = other_curr->next;
-        }
-        this->n_nodes = other.n_nodes;
+      catch (...) {
+        this->clear();
+        throw;
       }
     }
 
     // Move constructor, transfer resource (does not perform deep copy)
-    LinkedList(LinkedList&& other) noexcept {
+    LinkedList(LinkedList&& other) noexcept : alloc(std::move(other.alloc)) {
       this->head = other.head;
       this->n_nodes = other.n_nodes;
       other.head = nullptr;
@@ -54,28 +90,34 @@ class LinkedList
 
     // Assignment operator, deep copy
     LinkedList& operator=(const LinkedList& other) {
-      this->clear();
-      if (other.head == nullptr) {
-        this->head = nullptr;
-        this->n_nodes = 0;
+      if (this == &other) {
+        return *this;
       }
-      else {
-        this->head = new Node(other.head->data);
-        node_ptr curr = this->head;
-        node_ptr other_curr = other.head->next;
-        while (other_curr != nullptr) {
-          curr->next = new Node(other_curr->data);
-          curr = curr->next;
-          other_curr = other_curr->next;
-        }
-        this->n_nodes = other.n_nodes;
+      this->clear();
+      if constexpr (node_traits::propagate_on_container_copy_assignment::value) {
+        this->alloc = other.alloc;
       }
+      this->copy_nodes(other);
       return *this;
     }
 
-    // Assignment operator, transfer resource (does not perform deep copy)
-    LinkedList& operator=(LinkedList&& other) noexcept {
+    // Assignment operator, transfer resource (does not perform deep copy), unless
+    // the allocators differ and do not propagate
+    LinkedList& operator=(LinkedList&& other) noexcept(
+        node_traits::propagate_on_container_move_assignment::value ||
+        node_traits::is_always_equal::value) {
+      if (this == &other) {
+        return *this;
+      }
       this->clear();
+      if constexpr (node_traits::propagate_on_container_move_assignment::value) {
+        this->alloc = std::move(other.alloc);
+      }
+      else if (this->alloc != other.alloc) {
+        this->copy_nodes(std::move(other));
+        other.clear();
+        return *this;
+      }
       this->head = other.head;
       this->n_nodes = other.n_nodes;
       other.head = nullptr;
@@ -83,13 +125,35 @@ class LinkedList
       return *this;
     }
 
+    /**
+     * @brief Get a copy of the allocator the list was constructed with.
+     */
+    allocator_type get_allocator() const {
+      return allocator_type(this->alloc);
+    }
+
     /**
      * @brief Insert a new node at the beginning of the list.
      * @param data The data to be stored in the new node.
      * @return The pointer to the new node.
      */
     node_ptr push_front(const T& data) {
-      node_ptr new_node = new Node(data, this->head);
+      return this->emplace_front(data);
+    }
+
+    node_ptr push_front(T&& data) {
+      return this->emplace_front(std::move(data));
+    }
+
+    /**
+     * @brief Insert a new node at the beginning of the list, constructing its data
+     *        in place.
+     * @param args The arguments of T's constructor.
+     * @return The pointer to the new node.
+     */
+    template <typename... Args>
+    node_ptr emplace_front(Args&&... args) {
+      node_ptr new_node = this->create_node(std::in_place, this->head, std::forward<Args>(args)...);
       if (this->head == nullptr) {
         // linked list is empty.
         this->head = new_node;
@@ -114,7 +178,7 @@ class LinkedList
       else {
         node_ptr temp = this->head;
         this->head = this->head->next;
-        delete temp;
+        this->destroy_node(temp);
         this->n_nodes--;
         return true;
       }
@@ -151,11 +215,26 @@ class LinkedList
       * @return The pointer to the new node.
       */
     node_ptr insert_after(node_ptr pivot, const T& data) {
+      return this->emplace_after(pivot, data);
+    }
+
+    node_ptr insert_after(node_ptr pivot, T&& data) {
+      return this->emplace_after(pivot, std::move(data));
+    }
+
+    /**
+      * @brief Insert a new node after the given node, constructing its data in place.
+      * @param pivot The node after which the new node is inserted.
+      * @param args The arguments of T's constructor.
+      * @return The pointer to the new node.
+      */
+    template <typename... Args>
+    node_ptr emplace_after(node_ptr pivot, Args&&... args) {
       if (pivot == nullptr) {
-        return push_front(data);
+        return this->emplace_front(std::forward<Args>(args)...);
       }
 
-      node_ptr new_node = new Node(data, pivot->next);
+      node_ptr new_node = this->create_node(std::in_place, pivot->next, std::forward<Args>(args)...);
       pivot->next = new_node;
       this->n_nodes++;
       return new_node;
@@ -178,7 +257,7 @@ class LinkedList
           return nullptr;
         }
         pivot_start->next = temp->next;
-        delete temp;
+        this->destroy_node(temp);
         this->n_nodes--;
 
         return pivot_start->next;
@@ -189,7 +268,7 @@ class LinkedList
         node_ptr temp = pivot_start->next;
         while (temp != pivot_end) {
           node_ptr next = temp->next;
-          delete temp;
+          this->destroy_node(temp);
           this->n_nodes--;
           temp = next;
         }
@@ -206,12 +285,158 @@ class LinkedList
       while (curr != nullptr) {
         node_ptr temp = curr;
         curr = curr->next;
-        delete temp;
+        this->destroy_node(temp);
       }
       this->head = nullptr;
       this->n_nodes = 0;
     }
 
+    /**
+     * @brief Forget all nodes in O(1), without destroying or deallocating them.
+     *        Only for lists whose memory is reclaimed all at once afterwards (a
+     *        NodePool in arena mode, std::pmr::monotonic_buffer_resource). The
+     *        destructors of the elements are not run.
+     */
+    void release() {
+      this->head = nullptr;
+      this->n_nodes = 0;
+    }
+
+    /**
+      * @brief Move all nodes of other after the given node, without reallocating them.
+      * @param pivot The node after which the nodes are inserted, nullptr for the front.
+      * @param other The list the nodes are taken from, empty afterwards.
+      */
+    void splice_after(node_ptr pivot, LinkedList& other) {
+      this->splice_after(pivot, other, nullptr, nullptr);
+    }
+
+    /**
+      * @brief Move the node after it in other after the given node.
+      * @param pivot The node after which the node is inserted, nullptr for the front.
+      * @param it The node before the one to move, nullptr for other's first node.
+      */
+    void splice_after(node_ptr pivot, LinkedList& other, node_ptr it) {
+      node_ptr node = it != nullptr ? it->next : other.head;
+      if (node == nullptr || (this == &other && (pivot == it || pivot == node))) {
+        return;
+      }
+      this->splice_after(pivot, other, it, node->next);
+    }
+
+    /**
+      * @brief Move the nodes of other strictly between first and last after the given
+      *        node, in O(number of nodes moved).
+      * @param pivot The node after which the nodes are inserted, nullptr for the front.
+      *              It must not be one of the moved nodes.
+      * @param first The node before the first one to move, nullptr for other's front.
+      * @param last The node after the last one to move, nullptr for other's end.
+      */
+    void splice_after(node_ptr pivot, LinkedList& other, node_ptr first, node_ptr last) {
+      // Nodes of another allocator cannot be adopted; move their data instead, one
+      // node at a time. A node leaves other only once its replacement exists here,
+      // so if constructing one throws, every element is still in one of the lists.
+      if (this->alloc != other.alloc) {
+        node_ptr node;
+        while ((node = first != nullptr ? first->next : other.head) != last) {
+          pivot = this->emplace_after(pivot, std::move(node->data));
+          if (first != nullptr) {
+            first->next = node->next;
+          }
+          else {
+            other.head = node->next;
+          }
+          other.n_nodes--;
+          other.destroy_node(node);
+        }
+        return;
+      }
+
+      node_ptr begin = first != nullptr ? first->next : other.head;
+      if (begin == last) {
+        return;
+      }
+      node_ptr end = begin;
+      unsigned int count = 1;
+      while (end->next != last) {
+        end = end->next;
+        count++;
+      }
+
+      // Unlink [begin, end] from other.
+      if (first != nullptr) {
+        first->next = last;
+      }
+      else {
+        other.head = last;
+      }
+      other.n_nodes -= count;
+
+      if (pivot != nullptr) {
+        end->next = pivot->next;
+        pivot->next = begin;
+      }
+      else {
+        end->next = this->head;
+        this->head = begin;
+      }
+      this->n_nodes += count;
+    }
+
+    /**
+     * @brief Merge the sorted list other into this sorted list, relinking its nodes.
+     *        Equal elements of this list stay before those of other.
+     * @param comp The order the lists are sorted in.
+     */
+    template <typename Compare = std::less<>>
+    void merge(LinkedList& other, Compare comp = {}) {
+      if (this == &other) {
+        return;
+      }
+      if (this->alloc != other.alloc) {
+        // Move other's elements over one by one, each after the last element of
+        // this list that does not compare greater.
+        node_ptr prev = nullptr;
+        node_ptr curr = this->head;
+        while (other.head != nullptr) {
+          while (curr != nullptr && !comp(other.head->data, curr->data)) {
+            prev = curr;
+            curr = curr->next;
+          }
+          this->splice_after(prev, other, nullptr);
+          prev = prev != nullptr ? prev->next : this->head;
+        }
+        return;
+      }
+      this->head = merge_chains(this->head, other.head, comp).first;
+      this->n_nodes += other.n_nodes;
+      other.head = nullptr;
+      other.n_nodes = 0;
+    }
+
+    /**
+     * @brief Sort the list with a stable bottom-up merge sort, in O(n log n) time
+     *        and O(1) extra memory. Only links are changed; no node is allocated,
+     *        freed or moved, so pointers to nodes stay valid.
+     * @param comp The order to sort in.
+     */
+    template <typename Compare = std::less<>>
+    void sort(Compare comp = {}) {
+      // Pass p merges neighbouring sorted runs of width 2^p.
+      for (unsigned int width = 1; width < this->n_nodes; width *= 2) {
+        node_ptr rest = this->head;
+        node_ptr* link = &this->head;
+        while (rest != nullptr) {
+          node_ptr left = rest;
+          node_ptr right = cut_after(left, width);
+          rest = cut_after(right, width);
+          auto [merged, last] = merge_chains(left, right, comp);
+          *link = merged;
+          link = &last->next;
+        }
+      }
+    }
+
     /**
      * @brief Print the list.
      */
@@ -231,8 +456,89 @@ class LinkedList
     }
 
   private:
+    using node_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using node_traits = std::allocator_traits<node_allocator>;
+
     node_ptr head;
     unsigned int n_nodes;
+    [[no_unique_address]] node_allocator alloc;
+
+    template <typename... Args>
+    node_ptr create_node(Args&&... args) {
+      node_ptr node = node_traits::allocate(this->alloc, 1);
+      try {
+        node_traits::construct(this->alloc, node, std::forward<Args>(args)...);
+      }
+      catch (...) {
+        node_traits::deallocate(this->alloc, node, 1);
+        throw;
+      }
+      return node;
+    }
+
+    void destroy_node(node_ptr node) {
+      node_traits::destroy(this->alloc, node);
+      node_traits::deallocate(this->alloc, node, 1);
+    }
+
+    // Cuts the chain starting at node after n nodes and returns the rest.
+    static node_ptr cut_after(node_ptr node, unsigned int n) {
+      for (unsigned int i = 1; node != nullptr && i < n; i++) {
+        node = node->next;
+      }
+      if (node == nullptr) {
+        return nullptr;
+      }
+      node_ptr rest = node->next;
+      node->next = nullptr;
+      return rest;
+    }
+
+    // Merges the sorted chains a and b, taking from a on ties.
+    // Returns the first and the last node of the merged chain.
+    template <typename Compare>
+    static std::pair<node_ptr, node_ptr> merge_chains(node_ptr a, node_ptr b, Compare& comp) {
+      node_ptr merged = nullptr;
+      node_ptr* link = &merged;
+      while (a != nullptr && b != nullptr) {
+        if (comp(b->data, a->data)) {
+          *link = b;
+          b = b->next;
+        }
+        else {
+          *link = a;
+          a = a->next;
+        }
+        link = &(*link)->next;
+      }
+      *link = a != nullptr ? a : b;
+
+      node_ptr last = merged;
+      while (last != nullptr && last->next != nullptr) {
+        last = last->next;
+      }
+      return {merged, last};
+    }
+
+    // Appends copies of the elements of other to this (empty) list, or moves them
+    // out of other if it is an rvalue.
+    template <typename List>
+    void copy_nodes(List&& other) {
+      node_ptr* link = &this->head;
+      for (node_ptr curr = other.head; curr != nullptr; curr = curr->next) {
+        if constexpr (std::is_rvalue_reference_v<List&&>) {
+          *link = this->create_node(std::in_place, nullptr, std::move(curr->data));
+        }
+        else {
+          *link = this->create_node(std::in_place, nullptr, curr->data);
+        }
+        link = &(*link)->next;
+        this->n_nodes++;
+      }
+    }
 };
 
+template <typename T>
+using PmrLinkedList = LinkedList<T, std::pmr::polymorphic_allocator<T>>;
+
 #endif // end of linkedlist.h definition
@@ -3,6 +3,49 @@
 
 #include "bits/stdc++.h"
 #include "linkedlist.h"
+#include "../NodePool/nodepool.h"
+
+// A payload that counts how often it is copied and moved.
+struct Payload {
+    static inline int copies = 0;
+    static inline int moves = 0;
+
+    std::string text;
+    std::vector<char> bytes;
+
+    Payload(std::string text, size_t n) : text(std::move(text)), bytes(n, 'x') {}
+    Payload(const Payload& other) : text(other.text), bytes(other.bytes) { copies++; }
+    Payload(Payload&& other) noexcept : text(std::move(other.text)), bytes(std::move(other.bytes)) {
+        moves++;
+    }
+
+    static void reset() {
+        copies = 0;
+        moves = 0;
+    }
+};
+
+
+// A value whose copy or move constructor throws once copies_left copies or
+// moves_left moves have been made.
+struct ThrowingValue {
+    static inline int copies_left = INT_MAX;
+    static inline int moves_left = INT_MAX;
+
+    int value;
+
+    ThrowingValue(int value) : value(value) {}
+    ThrowingValue(const ThrowingValue& other) : value(other.value) {
+        if (copies_left-- <= 0) {
+            throw std::runtime_error("copy failed");
+        }
+    }
+    ThrowingValue(ThrowingValue&& other) : value(other.value) {
+        if (moves_left-- <= 0) {
+            throw std::runtime_error("move failed");
+        }
+    }
+};
 
 TEST_CASE("LinkedList and std::forward_list - Push Front", "[LinkedList]") {
     LinkedList<int> custom_list;
@@ -225,3 +268,348 @@ TEST_CASE("LinkedList - Assignment Operator Transfer Resource", "[LinkedList]")
     REQUIRE(moved_it == nullptr);
     REQUIRE(std_it == std_list.end());
 }
+
+TEST_CASE("LinkedList - Node Pool Recycles Freed Nodes", "[LinkedList]") {
+    NodePool pool;
+    PmrLinkedList<int> custom_list(&pool);
+
+    for (int round = 0; round < 100; round++) {
+        for (int i = 0; i < 1000; i++) {
+            custom_list.push_front(i);
+        }
+        REQUIRE(pool.blocks_in_use() == 1000);
+        custom_list.clear();
+        REQUIRE(pool.blocks_in_use() == 0);
+    }
+
+    // 1000 nodes of 16 bytes fit in one slab, and every round reuses them.
+    REQUIRE(pool.slab_count() == 1);
+
+    auto pivot = custom_list.push_front(1);
+    custom_list.insert_after(pivot, 3);
+    custom_list.insert_after(pivot, 2);
+    custom_list.erase_after(pivot);
+    custom_list.pop_front();
+    REQUIRE(custom_list.size() == 1);
+    REQUIRE(custom_list.front()->data == 3);
+    REQUIRE(pool.blocks_in_use() == 1);
+}
+
+TEST_CASE("LinkedList - Arena Release", "[LinkedList]") {
+    NodePool arena(NodePoolMode::Arena);
+    {
+        PmrLinkedList<int> custom_list(&arena);
+        for (int i = 0; i < 100000; i++) {
+            custom_list.push_front(i);
+        }
+        REQUIRE(custom_list.size() == 100000);
+        custom_list.release();
+        REQUIRE(custom_list.empty());
+        REQUIRE(custom_list.front() == nullptr);
+    }
+    REQUIRE(arena.slab_count() > 1);
+    arena.release();
+    REQUIRE(arena.slab_count() == 0);
+}
+
+TEST_CASE("LinkedList - Allocators Through Copy and Move", "[LinkedList]") {
+    NodePool pool_a, pool_b;
+    PmrLinkedList<std::string> list_a(&pool_a);
+    list_a.push_front("c");
+    list_a.push_front("b");
+    list_a.push_front("a");
+
+    // Copies of a pmr list use the default resource, like std::pmr containers.
+    PmrLinkedList<std::string> copied_list(list_a);
+    REQUIRE(copied_list.get_allocator().resource() == std::pmr::get_default_resource());
+    REQUIRE(pool_a.blocks_in_use() == 3);
+
+    // Moving into a list on another pool copies the nodes into that pool.
+    PmrLinkedList<std::string> list_b(&pool_b);
+    list_b = std::move(list_a);
+    REQUIRE(list_a.empty());
+    REQUIRE(pool_a.blocks_in_use() == 0);
+    REQUIRE(pool_b.blocks_in_use() == 3);
+    REQUIRE(list_b.get_allocator().resource() == &pool_b);
+
+    // A move constructor takes the nodes and the allocator.
+    PmrLinkedList<std::string> moved_list(std::move(list_b));
+    REQUIRE(moved_list.get_allocator().resource() == &pool_b);
+    REQUIRE(pool_b.blocks_in_use() == 3);
+
+    std::forward_list<std::string> std_list = {"a", "b", "c"};
+    auto custom_it = moved_list.front();
+    auto std_it = std_list.begin();
+    while (custom_it != nullptr && std_it != std_list.end()) {
+        REQUIRE(custom_it->data == *std_it);
+        custom_it = custom_it->next;
+        ++std_it;
+    }
+    REQUIRE(custom_it == nullptr);
+    REQUIRE(std_it == std_list.end());
+
+    copied_list = moved_list;
+    REQUIRE(copied_list.size() == 3);
+    REQUIRE(copied_list.front()->next->data == "b");
+}
+
+TEST_CASE("LinkedList - Move and Emplace Without Copies", "[LinkedList]") {
+    LinkedList<Payload> custom_list;
+    Payload::reset();
+
+    Payload payload("first", 2048);
+    auto pivot = custom_list.push_front(std::move(payload));
+    REQUIRE(Payload::copies == 0);
+    REQUIRE(Payload::moves == 1);
+    REQUIRE(payload.bytes.empty());
+
+    custom_list.emplace_front("zeroth", 2048);
+    custom_list.emplace_after(pivot, "third", 16);
+    custom_list.insert_after(pivot, Payload("second", 2048));
+    REQUIRE(Payload::copies == 0);
+    REQUIRE(Payload::moves == 2);
+
+    std::vector<std::string> expected = {"zeroth", "first", "second", "third"};
+    auto custom_it = custom_list.front();
+    for (const auto& text : expected) {
+        REQUIRE(custom_it->data.text == text);
+        custom_it = custom_it->next;
+    }
+    REQUIRE(custom_it == nullptr);
+
+    // Copying the list copies every payload once.
+    LinkedList<Payload> copied_list(custom_list);
+    REQUIRE(Payload::copies == 4);
+    REQUIRE(copied_list.front()->next->next->next->data.bytes.size() == 16);
+
+    // Moving into a list on another pool moves the payloads instead of copying them.
+    NodePool pool_a, pool_b;
+    PmrLinkedList<Payload> list_a(&pool_a), list_b(&pool_b);
+    list_a.emplace_front("a", 100);
+    list_a.emplace_front("b", 100);
+    Payload::reset();
+    list_b = std::move(list_a);
+    REQUIRE(Payload::copies == 0);
+    REQUIRE(Payload::moves == 2);
+    REQUIRE(list_b.front()->data.text == "b");
+}
+
+TEST_CASE("LinkedList - Move Only Elements", "[LinkedList]") {
+    LinkedList<std::unique_ptr<int>> custom_list;
+    auto pivot = custom_list.push_front(std::make_unique<int>(1));
+    custom_list.emplace_after(pivot, new int(3));
+    custom_list.insert_after(pivot, std::make_unique<int>(2));
+
+    int expected = 1;
+    for (auto it = custom_list.front(); it != nullptr; it = it->next) {
+        REQUIRE(*it->data == expected++);
+    }
+    REQUIRE(expected == 4);
+
+    LinkedList<std::unique_ptr<int>> moved_list(std::move(custom_list));
+    REQUIRE(moved_list.size() == 3);
+}
+
+template <typename List>
+std::vector<int> to_vector(List& custom_list) {
+    std::vector<int> values;
+    for (auto it = custom_list.front(); it != nullptr; it = it->next) {
+        values.push_back(it->data);
+    }
+    return values;
+}
+
+LinkedList<int> make_list(const std::vector<int>& values) {
+    LinkedList<int> custom_list;
+    for (auto it = values.rbegin(); it != values.rend(); ++it) {
+        custom_list.push_front(*it);
+    }
+    return custom_list;
+}
+
+TEST_CASE("LinkedList and std::forward_list - Splice After", "[LinkedList]") {
+    LinkedList<int> custom_list = make_list({1, 2, 3});
+    LinkedList<int> other = make_list({10, 20, 30, 40, 50});
+    std::forward_list<int> std_list = {1, 2, 3};
+    std::forward_list<int> std_other = {10, 20, 30, 40, 50};
+
+    // One node: the one after 10, after 1.
+    custom_list.splice_after(custom_list.front(), other, other.front());
+    std_list.splice_after(std_list.begin(), std_other, std_other.begin());
+    REQUIRE(to_vector(custom_list) == std::vector<int>(std_list.begin(), std_list.end()));
+    REQUIRE(to_vector(other) == std::vector<int>(std_other.begin(), std_other.end()));
+    REQUIRE(custom_list.size() == 4);
+    REQUIRE(other.size() == 4);
+
+    // The range (10, 50), i.e. 30 and 40, at the front.
+    auto last = other.front()->next->next->next;
+    custom_list.splice_after(nullptr, other, other.front(), last);
+    std_list.splice_after(std_list.before_begin(), std_other, std_other.begin(),
+                          std::next(std_other.begin(), 3));
+    REQUIRE(to_vector(custom_list) == std::vector<int>(std_list.begin(), std_list.end()));
+    REQUIRE(to_vector(other) == std::vector<int>(std_other.begin(), std_other.end()));
+
+    // The rest of other at the end.
+    auto tail = custom_list.front();
+    while (tail->next != nullptr) {
+        tail = tail->next;
+    }
+    custom_list.splice_after(tail, other);
+    std_list.splice_after(std::next(std_list.begin(), 5), std_other);
+    REQUIRE(to_vector(custom_list) == std::vector<int>(std_list.begin(), std_list.end()));
+    REQUIRE(other.empty());
+    REQUIRE(other.front() == nullptr);
+    REQUIRE(custom_list.size() == 8);
+
+    // Within the same list: move the first node to the end.
+    auto first = custom_list.front();
+    while (tail->next != nullptr) {
+        tail = tail->next;
+    }
+    custom_list.splice_after(tail, custom_list, nullptr);
+    REQUIRE(tail->next == first);
+    REQUIRE(custom_list.size() == 8);
+}
+
+TEST_CASE("LinkedList - Splice Relinks Nodes Between Pools", "[LinkedList]") {
+    NodePool pool, other_pool;
+    PmrLinkedList<int> custom_list(&pool), same_pool(&pool), other(&other_pool);
+    for (int i = 0; i < 100; i++) {
+        same_pool.push_front(i);
+        other.push_front(i);
+    }
+
+    // Same pool: the nodes themselves change lists.
+    auto node = same_pool.front();
+    custom_list.splice_after(nullptr, same_pool);
+    REQUIRE(custom_list.front() == node);
+    REQUIRE(custom_list.size() == 100);
+    REQUIRE(pool.blocks_in_use() == 100);
+
+    // Another pool: the data moves into nodes of this list's pool.
+    custom_list.splice_after(custom_list.front(), other, nullptr, other.front()->next->next);
+    REQUIRE(custom_list.size() == 102);
+    REQUIRE(other.size() == 98);
+    REQUIRE(pool.blocks_in_use() == 102);
+    REQUIRE(other_pool.blocks_in_use() == 98);
+    REQUIRE(to_vector(custom_list)[1] == 99);
+    REQUIRE(to_vector(custom_list)[2] == 98);
+}
+
+TEST_CASE("LinkedList - Merge", "[LinkedList]") {
+    std::mt19937 rng(1);
+    for (int n : {0, 1, 5, 1000}) {
+        std::vector<int> a(n), b(n / 2 + 1);
+        for (int& x : a) x = rng() % 100;
+        for (int& x : b) x = rng() % 100;
+        std::sort(a.begin(), a.end());
+        std::sort(b.begin(), b.end());
+        std::vector<int> expected;
+        std::merge(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+
+        LinkedList<int> custom_list = make_list(a), other = make_list(b);
+        custom_list.merge(other);
+        REQUIRE(to_vector(custom_list) == expected);
+        REQUIRE(custom_list.size() == expected.size());
+        REQUIRE(other.empty());
+    }
+
+    LinkedList<int> descending = make_list({9, 5, 1}), other = make_list({8, 5, 2});
+    descending.merge(other, std::greater<>());
+    REQUIRE(to_vector(descending) == std::vector<int>{9, 8, 5, 5, 2, 1});
+}
+
+TEST_CASE("LinkedList - Bottom Up Merge Sort", "[LinkedList]") {
+    std::mt19937 rng(2);
+    for (int n : {0, 1, 2, 3, 17, 1000, 1024, 4099}) {
+        // Stable: sort (key, input position) pairs by key only.
+        NodePool pool;
+        PmrLinkedList<std::pair<int, int>> custom_list(&pool);
+        std::vector<std::pair<int, int>> expected;
+        for (int i = 0; i < n; i++) {
+            expected.push_back({int(rng() % 50), i});
+        }
+        for (auto it = expected.rbegin(); it != expected.rend(); ++it) {
+            custom_list.push_front(*it);
+        }
+
+        std::map<const void*, std::pair<int, int>> nodes;
+        for (auto it = custom_list.front(); it != nullptr; it = it->next) {
+            nodes[it] = it->data;
+        }
+        size_t slabs = pool.slab_count();
+
+        auto by_key = [](const auto& a, const auto& b) { return a.first < b.first; };
+        custom_list.sort(by_key);
+        std::stable_sort(expected.begin(), expected.end(), by_key);
+
+        // Same nodes, with the same data, relinked in sorted order.
+        std::vector<std::pair<int, int>> sorted;
+        for (auto it = custom_list.front(); it != nullptr; it = it->next) {
+            REQUIRE(nodes.at(it) == it->data);
+            sorted.push_back(it->data);
+        }
+        REQUIRE(sorted == expected);
+        REQUIRE(custom_list.size() == unsigned(n));
+        REQUIRE(pool.slab_count() == slabs);
+        REQUIRE(pool.blocks_in_use() == size_t(n));
+    }
+
+    LinkedList<int> custom_list = make_list({3, 1, 2});
+    custom_list.sort(std::greater<>());
+    REQUIRE(to_vector(custom_list) == std::vector<int>{3, 2, 1});
+}
+
+TEST_CASE("LinkedList - Splice And Merge Between Pools When A Move Throws", "[LinkedList]") {
+    for (bool use_merge : {false, true}) {
+        NodePool pool, other_pool;
+        PmrLinkedList<ThrowingValue> custom_list(&pool), other(&other_pool);
+        for (int i = 9; i >= 0; i--) {
+            other.push_front(ThrowingValue(i));
+        }
+
+        // The fifth element fails to move into this list's pool.
+        ThrowingValue::moves_left = 4;
+        if (use_merge) {
+            REQUIRE_THROWS_AS(custom_list.merge(other, [](const auto& a, const auto& b) {
+                return a.value < b.value;
+            }), std::runtime_error);
+        }
+        else {
+            REQUIRE_THROWS_AS(custom_list.splice_after(nullptr, other), std::runtime_error);
+        }
+        ThrowingValue::moves_left = INT_MAX;
+
+        // Nothing leaked: each element is in exactly one list, in its pool.
+        REQUIRE(custom_list.size() == 4);
+        REQUIRE(other.size() == 6);
+        REQUIRE(pool.blocks_in_use() == 4);
+        REQUIRE(other_pool.blocks_in_use() == 6);
+        std::vector<int> values;
+        for (auto it = custom_list.front(); it != nullptr; it = it->next) {
+            values.push_back(it->data.value);
+        }
+        for (auto it = other.front(); it != nullptr; it = it->next) {
+            values.push_back(it->data.value);
+        }
+        REQUIRE(values == std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+    }
+}
+
+TEST_CASE("LinkedList - Copy Constructor When A Copy Throws", "[LinkedList]") {
+    NodePool pool;
+    PmrLinkedList<ThrowingValue> other(&pool);
+    for (int i = 9; i >= 0; i--) {
+        other.push_front(ThrowingValue(i));
+    }
+
+    // A polymorphic_allocator copy uses the default resource, so make that the pool.
+    // The sixth element fails to copy; the five copied nodes must be freed.
+    std::pmr::memory_resource* previous = std::pmr::set_default_resource(&pool);
+    ThrowingValue::copies_left = 5;
+    REQUIRE_THROWS_AS(PmrLinkedList<ThrowingValue>(other), std::runtime_error);
+    ThrowingValue::copies_left = INT_MAX;
+    std::pmr::set_default_resource(previous);
+    REQUIRE(pool.blocks_in_use() == 10);
+    REQUIRE(other.size() == 10);
+}
@@ -0,0 +1,181 @@
+/* ==============================================================================
+   This is an implementation of a node pool: a std::pmr::memory_resource for
+   containers that allocate many small blocks of the same few sizes, such as the
+   nodes of LinkedList and DoublyLinkedList (use PmrLinkedList<T> and pass the
+   pool to the constructor).
+
+   The pool gets memory from its upstream resource in slabs of slab_bytes and
+   carves blocks out of them with a bump pointer. Requests are rounded up to a
+   multiple of NODE_POOL_GRANULE bytes, which is also the alignment of every
+   block, and each rounded size has its own free list.
+
+   - NodePoolMode::Recycle: a freed block goes to the free list of its size and
+     is handed out again by the next allocation of that size, so a list that
+     keeps churning nodes stops allocating once it has reached its peak size.
+   - NodePoolMode::Arena: freeing a block does nothing. Memory only comes back
+     with release() (or the pool's destructor), which returns every slab at
+     once. Together with the lists' release(), which forgets all nodes without
+     visiting them, a whole list is thrown away in O(1) per slab instead of one
+     delete per node.
+
+   Blocks larger than NODE_POOL_MAX_BLOCK bytes or more aligned than
+   NODE_POOL_GRANULE get their own slab in arena mode and come straight from
+   upstream in recycle mode.
+
+   The pool is not thread safe, like std::pmr::unsynchronized_pool_resource.
+   Share one pool between the lists of one thread.
+
+   @author: Muhammad Fadli Alim Arsani
+===============================================================================*/
+
+#ifndef NODEPOOL_H
+#define NODEPOOL_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+const std::size_t NODE_POOL_GRANULE = 16;
+const std::size_t NODE_POOL_MAX_BLOCK = 256;
+const std::size_t NODE_POOL_SLAB_BYTES = 1 << 16;
+
+enum class NodePoolMode { Recycle, Arena };
+
+class NodePool : public std::pmr::memory_resource {
+  public:
+    explicit NodePool(NodePoolMode mode = NodePoolMode::Recycle,
+                      std::size_t slab_bytes = NODE_POOL_SLAB_BYTES,
+                      std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : mode(mode), slab_bytes(std::max(slab_bytes, sizeof(Slab) + NODE_POOL_MAX_BLOCK)),
+          upstream(upstream) {}
+
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    // Destructor
+    ~NodePool() {
+      this->release();
+    }
+
+    /**
+     * @brief Return every slab to upstream. All blocks handed out become invalid.
+     */
+    void release() {
+      while (this->slabs != nullptr) {
+        Slab* next = this->slabs->next;
+        this->upstream->deallocate(this->slabs, this->slabs->bytes, alignof(Slab));
+        this->slabs = next;
+      }
+      this->cursor = nullptr;
+      this->end = nullptr;
+      this->free_lists.fill(nullptr);
+      this->n_slabs = 0;
+      this->n_blocks = 0;
+    }
+
+    /**
+     * @brief Get the number of slabs taken from upstream.
+     */
+    std::size_t slab_count() const {
+      return this->n_slabs;
+    }
+
+    /**
+     * @brief Get the number of pooled blocks handed out and not freed.
+     */
+    std::size_t blocks_in_use() const {
+      return this->n_blocks;
+    }
+
+    NodePoolMode get_mode() const {
+      return this->mode;
+    }
+
+  private:
+    // The header of a slab. The blocks follow it.
+    struct alignas(NODE_POOL_GRANULE) Slab {
+      Slab* next;
+      std::size_t bytes;
+    };
+
+    struct FreeBlock {
+      FreeBlock* next;
+    };
+
+    NodePoolMode mode;
+    std::size_t slab_bytes;
+    std::pmr::memory_resource* upstream;
+    Slab* slabs = nullptr;
+    char* cursor = nullptr;
+    char* end = nullptr;
+    std::array<FreeBlock*, NODE_POOL_MAX_BLOCK / NODE_POOL_GRANULE> free_lists{};
+    std::size_t n_slabs = 0;
+    std::size_t n_blocks = 0;
+
+    static bool pooled(std::size_t bytes, std::size_t alignment) {
+      return bytes <= NODE_POOL_MAX_BLOCK && alignment <= NODE_POOL_GRANULE;
+    }
+
+    static std::size_t size_class(std::size_t bytes) {
+      return bytes == 0 ? 0 : (bytes - 1) / NODE_POOL_GRANULE;
+    }
+
+    // Gets a slab with room for at least `bytes` after its header.
+    char* new_slab(std::size_t bytes) {
+      std::size_t total = sizeof(Slab) + bytes;
+      Slab* slab = static_cast<Slab*>(this->upstream->allocate(total, alignof(Slab)));
+      slab->next = this->slabs;
+      slab->bytes = total;
+      this->slabs = slab;
+      this->n_slabs++;
+      return reinterpret_cast<char*>(slab + 1);
+    }
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+      if (!pooled(bytes, alignment)) {
+        if (this->mode == NodePoolMode::Recycle) return this->upstream->allocate(bytes, alignment);
+        std::size_t padded = bytes + std::max(alignment, NODE_POOL_GRANULE);
+        void* p = this->new_slab(padded);
+        return std::align(alignment, bytes, p, padded);
+      }
+
+      std::size_t c = size_class(bytes);
+      this->n_blocks++;
+      if (this->free_lists[c] != nullptr) {
+        FreeBlock* block = this->free_lists[c];
+        this->free_lists[c] = block->next;
+        return block;
+      }
+
+      std::size_t block_bytes = (c + 1) * NODE_POOL_GRANULE;
+      if (this->cursor == nullptr || static_cast<std::size_t>(this->end - this->cursor) < block_bytes) {
+        this->cursor = this->new_slab(this->slab_bytes - sizeof(Slab));
+        this->end = this->cursor + (this->slab_bytes - sizeof(Slab));
+      }
+      void* block = this->cursor;
+      this->cursor += block_bytes;
+      return block;
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+      if (!pooled(bytes, alignment)) {
+        if (this->mode == NodePoolMode::Recycle) this->upstream->deallocate(p, bytes, alignment);
+        return;
+      }
+
+      this->n_blocks--;
+      if (this->mode == NodePoolMode::Arena) return;
+      std::size_t c = size_class(bytes);
+      FreeBlock* block = static_cast<FreeBlock*>(p);
+      block->next = this->free_lists[c];
+      this->free_lists[c] = block;
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+      return this == &other;
+    }
+};
+
+#endif // end of nodepool.h definition